@@ -105,5 +105,14 @@ public:
 	{}
 };
 
+
+//    CancellationToken
+class Cancelled : public BaseException{
+public:
+	Cancelled(const std::string& desc = "", const std::string& file = __FILE__, uint32_t line = __LINE__)
+		: BaseException("Cancelled", desc, file, line)
+	{}
+};
+
 }
 }
\ No newline at end of file
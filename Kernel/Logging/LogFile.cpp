@@ -14,11 +14,11 @@ namespace Logging
 using namespace Multithreading;
 
 
-LogFile::LogFile(const std::string& filename, uint32_t bufferSize, uint32_t spinSleep_ms)
+LogFile::LogFile(const std::string& filename, uint32_t bufferSize, uint32_t spinCount)
 	: m_filename(filename),
 	m_writeTime(true),
 	m_writeThreadID(true),
-	m_lock(spinSleep_ms)
+	m_lock(spinCount)
 {
 	m_file.open(m_filename);
 
@@ -41,7 +41,7 @@ void LogFile::SetWriteThreadID(bool b){
 
 
 void LogFile::Write(const char* fmt, ...){
-	std::lock_guard<Multithreading::Spinlock> lock(m_lock);
+	std::lock_guard<Multithreading::TicketLock> lock(m_lock);
 	WritePrefix();
 	
 	std::string buf;
@@ -55,21 +55,21 @@ void LogFile::Write(const char* fmt, ...){
 }
 
 void LogFile::operator<<(const char* str){
-	std::lock_guard<Multithreading::Spinlock> lock(m_lock);
+	std::lock_guard<Multithreading::TicketLock> lock(m_lock);
 	WritePrefix();
 	
 	m_file << str << "\n";
 }
 
 void LogFile::operator<<(const std::string& str){
-	std::lock_guard<Multithreading::Spinlock> lock(m_lock);
+	std::lock_guard<Multithreading::TicketLock> lock(m_lock);
 	WritePrefix();
 	
 	m_file << str << "\n";
 }
 
 void LogFile::operator<<(const Exception::BaseException& e){
-	std::lock_guard<Multithreading::Spinlock> lock(m_lock);
+	std::lock_guard<Multithreading::TicketLock> lock(m_lock);
 	WritePrefix();
 	
 	m_file << e.What() << "\n";
@@ -4,7 +4,7 @@
 #pragma once
 
 #include "ILog.h"
-#include "..\Multithreading\Spinlock.h"
+#include "..\Multithreading\TicketLock.h"
 #include <fstream>
 
 
@@ -16,7 +16,7 @@ namespace Logging
 class KERNEL_API LogFile : public ILog{
 public:
 //NOTE: bufferSize     
-	LogFile(const std::string& filename, uint32_t bufferSize = 512, uint32_t spinSleep_ms = 5);
+	LogFile(const std::string& filename, uint32_t bufferSize = 512, uint32_t spinCount = 64);
 	~LogFile();
 
 	void				SetWriteTime(bool b);
@@ -37,7 +37,7 @@ private:
 
 private:
 	std::ofstream				m_file;						// NOTE:  
-	Multithreading::Spinlock	m_lock;
+	Multithreading::TicketLock	m_lock;						// :     
 
 	std::string					m_filename;
 
@@ -14,7 +14,8 @@ Memory::PoolAllocator<LogFile>		g_logFilePool(5);
 
 
 LogManager::LogManager()
-	: m_logsFolder("Logs\\"), 
+	: m_handles(4),
+	m_logsFolder("Logs\\"), 
 	m_messageTypeEnabled(MT_Info | MT_Warning | MT_Error | MT_Debug)
 {}
 
@@ -39,6 +40,7 @@ LogHandle LogManager::CreateLog(const std::string& name, LogType logType){
 	case LT_File:
 		m_logs.emplace_back( std::make_pair(name, Memory::CreateShared<LogFile>(g_logFilePool, filepath)) );
 		handle = LogHandle(m_logs.size() - 1);
+		m_handles.insert(name, handle);				//       
 		break;
 	}
 
@@ -161,10 +163,9 @@ const ILog& LogManager::Log(const std::string& name) const{
 }
 
 LogHandle LogManager::GetHandleByName(const std::string& name) const{
-	Multithreading::ReadLockGuard lock(m_rwLock);
-	for(size_t i=0; i<m_logs.size(); i++)
-		if(m_logs[i].first == name)
-			return LogHandle(i);
+	LogHandle handle;
+	if(m_handles.find(name, &handle))
+		return handle;
 	return LogHandle(-1);
 }
 
@@ -9,6 +9,7 @@
 #include "Logging.h"
 #include "..\Exception\Exception.h"
 #include "..\Multithreading\RWSpinlock.h"
+#include "..\Multithreading\ConcurrentHashMap.h"
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -89,6 +90,7 @@ private:
 	mutable Multithreading::RWSpinlock								m_rwLock;
 
 	std::vector< std::pair<std::string, std::shared_ptr<ILog>> >	m_logs;
+	Multithreading::ConcurrentHashMap<std::string, LogHandle>		m_handles;				//     
 	std::string														m_logsFolder;
 	std::atomic<uint32_t>											m_messageTypeEnabled;
 };
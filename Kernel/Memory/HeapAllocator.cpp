@@ -9,20 +9,18 @@ namespace Memory
 {
 
 HeapAllocator::HeapAllocator(uint32_t pageSize_kb, uint16_t heapNum, float ff, HeapAllocator::SearchStrategy strategy) 
-	: m_pageSize(pageSize_kb * 1024),
+	: m_heaps(heapNum + 1),
+	m_pageSize(pageSize_kb * 1024),
 	m_freeFracture(ff),
 	m_strategy(strategy)
 {
-	m_heaps.resize(heapNum + 1);
 }
 
 HeapAllocator::~HeapAllocator(){
 	for(Heap& h : m_heaps){
-		while(!h.segments.empty()){
-			HeapSegment* seg;
-			if(h.segments.try_get_and_pop_back(&seg))
-				Delete(m_segPool, seg);
-		}
+		HeapSegment* seg;
+		while(h.segments.pop_back(&seg))
+			Delete(m_segPool, seg);
 	}
 }
 
@@ -47,8 +45,8 @@ void HeapAllocator::Deallocate(void* ptr){
 	float fracture = seg->GetUsedMemorySize() / static_cast<float>( seg->GetFreeMemorySize() );
 	if(fracture < m_freeFracture){
 		uint16_t heapIndx = seg->GetHeapOwner();
-		m_heaps[heapIndx].segments.try_erase(seg);
-		AddSegment(0, seg);
+		if(m_heaps[heapIndx].segments.try_erase(seg))		//      
+			AddSegment(0, seg);
 	}
 }
 
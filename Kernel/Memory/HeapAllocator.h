@@ -11,9 +11,9 @@
 #include "IAllocator.h"
 #include "PoolAllocator.h"
 #include "HeapSegment.h"
-#include "../Multithreading/SafeContainer.h"
+#include "../Multithreading/List.h"
+#include "../Multithreading/Topology.h"
 #include <thread>
-#include <list>
 #include <vector>
 
 
@@ -24,8 +24,7 @@ namespace Memory
 
 class KERNEL_API HeapAllocator : public IAllocator{
 public:
-//TODO:     
-	typedef Multithreading::SafeContainer< std::list<HeapSegment*> >	SegmentList;
+	typedef Multithreading::List<HeapSegment*>	SegmentList;
 
 	struct Heap{
 		SegmentList	segments;
@@ -42,9 +41,9 @@ private:
 	HeapAllocator& operator=(const HeapAllocator&) = delete;
 
 public:
-// pageSize_kb -    , heapNum -  thread-local , 
+// pageSize_kb -    , heapNum -  thread-local  (  -     ), 
 // ff (free fracture) -    ,          
-	HeapAllocator(uint32_t pageSize_kb = 16, uint16_t heapNum = std::thread::hardware_concurrency(), float ff = 0.1f, SearchStrategy strategy = BestFit);
+	HeapAllocator(uint32_t pageSize_kb = 16, uint16_t heapNum = Multithreading::Topology::Instance().GetLogicalCpuCount(), float ff = 0.1f, SearchStrategy strategy = BestFit);
 	~HeapAllocator();
 
 	void*			Allocate(uint32_t size);
@@ -71,7 +70,7 @@ private:
 
 private:
 	PoolAllocator<HeapSegment>	m_segPool;
-	std::vector<Heap>			m_heaps;			// m_heaps[0] -  ,  - thread-local  
+	std::vector<Heap>			m_heaps;			// m_heaps[0] -  ,  - thread-local ;      (Heap )
 	uint32_t					m_pageSize;			//    
 	float						m_freeFracture;		//    ,       
 	SearchStrategy				m_strategy;
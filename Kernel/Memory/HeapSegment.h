@@ -10,7 +10,7 @@
 #include "IAllocator.h"
 #include "Arena.h"
 #include "Align.h"
-#include "..\Multithreading\RWSpinlock.h"
+#include "..\Multithreading\BravoRWLock.h"
 #include <mutex>
 
 
@@ -67,7 +67,7 @@ private:
 
 private:
 	mutable Arena						m_arena;
-	mutable Multithreading::RWSpinlock	m_rwlock;
+	mutable Multithreading::BravoRWLock	m_rwlock;
 
 	void**								m_bin;				//        ( sizeof(m_bin[i]) = 2^i ) 
 	uint16_t							m_binSize;			//     m_bin
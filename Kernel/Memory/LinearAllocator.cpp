@@ -30,23 +30,18 @@ void* LinearAllocator::Allocate(uint32_t size){
 
 void* LinearAllocator::Allocate(uint32_t size, const Align& align){
 	WriteLockGuard lock(m_rwlock);
-
-	uint8_t* mem = m_top;
-	uint16_t adj = align.ComputeAdjustment(mem);
-
-	if(GetFreeMemorySize_unsafe() < size + adj)
-		RGE_Throw(Exception::NotEnoughMemory, "");
-
-	mem += adj;
-	memset(mem, 0, size);
-	m_top += size + adj;
-	return mem;
+	return Allocate_unsafe(size, align);
 }
 
 
 void LinearAllocator::Clear(){
 	WriteLockGuard lock(m_rwlock);
-	m_top = static_cast<uint8_t*>( m_arena.GetMemoryBegin() );
+	Clear_unsafe();
+}
+
+void LinearAllocator::Rollback(uint32_t usedSize){
+	WriteLockGuard lock(m_rwlock);
+	Rollback_unsafe(usedSize);
 }
 
 
@@ -56,12 +51,12 @@ uint32_t LinearAllocator::GetMaximumAllocationSize() const{
 
 uint32_t LinearAllocator::GetFreeMemorySize() const{
 	ReadLockGuard lock(m_rwlock);
-	return m_arena.GetSize() - GetUsedMemorySize();
+	return GetFreeMemorySize_unsafe();
 }
 
 uint32_t LinearAllocator::GetUsedMemorySize() const{
 	ReadLockGuard lock(m_rwlock);
-	return m_top - static_cast<uint8_t*>( m_arena.GetMemoryBegin() );
+	return GetUsedMemorySize_unsafe();
 }
 
 
@@ -70,8 +65,36 @@ bool LinearAllocator::IsMemoryAllocatedHere(const void* ptr) const{
 }
 
 
+void* LinearAllocator::Allocate_unsafe(uint32_t size, const Align& align){
+	uint8_t* mem = m_top;
+	uint16_t adj = align.ComputeAdjustment(mem);
+
+	if(GetFreeMemorySize_unsafe() < size + adj)
+		RGE_Throw(Exception::NotEnoughMemory, "");
+
+	mem += adj;
+	memset(mem, 0, size);
+	m_top += size + adj;
+	return mem;
+}
+
+void LinearAllocator::Clear_unsafe(){
+	m_top = static_cast<uint8_t*>( m_arena.GetMemoryBegin() );
+}
+
+void LinearAllocator::Rollback_unsafe(uint32_t usedSize){
+	uint8_t* mark = static_cast<uint8_t*>( m_arena.GetMemoryBegin() ) + usedSize;
+	RGE_Assert(mark <= m_top, Exception::WrongArgument, "Rollback mark is above the top");
+	m_top = mark;
+}
+
+uint32_t LinearAllocator::GetUsedMemorySize_unsafe() const{
+	return m_top - static_cast<uint8_t*>( m_arena.GetMemoryBegin() );
+}
+
+
 uint32_t LinearAllocator::GetFreeMemorySize_unsafe() const{
-	return m_arena.GetSize() - ( m_top - static_cast<uint8_t*>(m_arena.GetMemoryBegin()) );
+	return m_arena.GetSize() - GetUsedMemorySize_unsafe();
 }
 
 }
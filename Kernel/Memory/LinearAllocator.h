@@ -30,6 +30,7 @@ public:
 
 	void		Deallocate(void*){}								// -.    Clear()
 	void		Clear();										//   ,   
+	void		Rollback(uint32_t usedSize);					//    ,   GetUsedMemorySize()
 
 	uint32_t	GetMaximumAllocationSize() const;
 	uint32_t	GetFreeMemorySize() const;
@@ -37,6 +38,12 @@ public:
 
 	bool		IsMemoryAllocatedHere(const void* ptr) const;
 
+//  :   ,     (, scratch )
+	void*		Allocate_unsafe(uint32_t size, const Align& align);
+	void		Clear_unsafe();
+	void		Rollback_unsafe(uint32_t usedSize);
+	uint32_t	GetUsedMemorySize_unsafe() const;
+
 private:
 	uint32_t	GetFreeMemorySize_unsafe() const;				//     
 
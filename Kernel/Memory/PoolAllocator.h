@@ -11,7 +11,7 @@
 #include "Arena.h"
 #include "IAllocator.h"
 #include "Align.h"
-#include "../Multithreading/RWSpinlock.h"
+#include "../Multithreading/BravoRWLock.h"
 #include <algorithm>
 
 
@@ -78,7 +78,7 @@ public:
 		if(ptr == nullptr)	return;
 
 		Multithreading::WriteLockGuard	lock(m_rwlock);
-		RGE_Assert(IsMemoryAllocatedHere(ptr), Exception::WrongArgument, "Memory wasn't allocated here");
+		RGE_Assert(IsPointerFromArenas(ptr), Exception::WrongArgument, "Memory wasn't allocated here");
 
 		Link* elem = static_cast<Link*>(ptr);
 		elem->next = m_fstFree;
@@ -133,6 +133,13 @@ public:
 	}
 
 	bool IsMemoryAllocatedHere(const void* ptr) const{
+		Multithreading::ReadLockGuard	lock(m_rwlock);
+		return IsPointerFromArenas(ptr);
+	}
+
+private:
+//   
+	bool IsPointerFromArenas(const void* ptr) const{
 		Arena* curArena = m_fstArena;
 		while(curArena != nullptr){
 			if(curArena->IsPointerFromHere(ptr))
@@ -142,7 +149,6 @@ public:
 		return false;
 	}
 
-private:
 //   :	|adjust|Link/Object|... (Link    )
 //   :	|adjust|Object|...
 	uint32_t InitializeMemory(Arena* arena){
@@ -192,7 +198,7 @@ private:
 	uint32_t	m_totalCount;
 	uint32_t	m_freeCount;
 
-	mutable Multithreading::RWSpinlock		m_rwlock;
+	mutable Multithreading::BravoRWLock		m_rwlock;
 };
 
 }
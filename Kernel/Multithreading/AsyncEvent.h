@@ -0,0 +1,84 @@
+/****************************************************************************
+*	 ,      (co_await event);	*
+*	Set    , ,   	*
+*	-;     				*
+*	;      Wait					*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Coroutine.h"
+#include "Continuation.h"
+#include "AtomicWait.h"
+#include <atomic>
+#include <coroutine>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class AsyncEvent{
+private:
+	class Awaiter : public ResumeContinuation{
+	public:
+		Awaiter(AsyncEvent& ev) : m_event(ev){}
+
+		bool await_ready() const{
+			return m_event.IsSet();
+		}
+
+		template <class Promise>
+		bool await_suspend(std::coroutine_handle<Promise> handle){
+			Bind(handle);
+			return m_event.m_continuations.TryAdd(this);
+		}
+
+		void await_resume() const{}
+
+	private:
+		AsyncEvent&		m_event;
+	};
+
+	AsyncEvent(const AsyncEvent&) = delete;
+	AsyncEvent& operator=(const AsyncEvent&) = delete;
+
+public:
+	AsyncEvent(){
+		m_isSet.store(false);
+	}
+
+	void Set(){
+		m_isSet.store(true, std::memory_order_release);
+		m_isSet.notify_all();
+		m_continuations.Close();
+	}
+
+//  ,      
+	void Reset(){
+		m_isSet.store(false, std::memory_order_relaxed);
+		m_continuations.Reset();
+	}
+
+	bool IsSet() const{
+		return m_isSet.load(std::memory_order_acquire);
+	}
+
+	void Wait() const{
+		while(!m_isSet.load(std::memory_order_acquire))
+			m_spin.Wait(m_isSet, false);
+	}
+
+	Awaiter operator co_await(){
+		return Awaiter(*this);
+	}
+
+private:
+	std::atomic_bool		m_isSet;
+	ContinuationList		m_continuations;
+	mutable AdaptiveSpin	m_spin;
+};
+
+}
+}
\ No newline at end of file
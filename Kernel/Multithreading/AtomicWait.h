@@ -0,0 +1,55 @@
+/****************************************************************************
+*	   :  , 		*
+*	  std::atomic::wait (futex / WaitOnAddress);				*
+*	  :    			*
+*	   ,  ,  - 		*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Backoff.h"
+#include <atomic>
+#include <cstdint>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class AdaptiveSpin{
+private:
+	static const uint32_t	MIN_SPIN_COUNT = 16;
+	static const uint32_t	MAX_SPIN_COUNT = 4096;
+
+public:
+	AdaptiveSpin(uint32_t spinCount = 256){
+		m_spinCount.store(spinCount, std::memory_order_relaxed);
+	}
+
+//  ,  value != old
+	template <class T>
+	void Wait(const std::atomic<T>& value, T old){
+		uint32_t spinCount = m_spinCount.load(std::memory_order_relaxed);
+		for(uint32_t i=0; i<spinCount; i++){
+			if(value.load(std::memory_order_acquire) != old){
+				if(spinCount < MAX_SPIN_COUNT)
+					m_spinCount.store(spinCount + spinCount/8 + 1, std::memory_order_relaxed);
+				return;
+			}
+			RGE_CPU_RELAX();
+		}
+
+		if(spinCount > MIN_SPIN_COUNT)
+			m_spinCount.store(spinCount - spinCount/4, std::memory_order_relaxed);
+
+		while(value.load(std::memory_order_acquire) == old)
+			value.wait(old, std::memory_order_acquire);
+	}
+
+private:
+	std::atomic<uint32_t>	m_spinCount;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+/****************************************************************************
+*	    :   Pause		*
+*	   pause,    		*
+*	   (yield)											*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include <cstdint>
+#include <thread>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#define RGE_CPU_RELAX()		_mm_pause()
+#else
+#define RGE_CPU_RELAX()		std::this_thread::yield()
+#endif
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class Backoff{
+public:
+	Backoff(uint32_t maxPauseCount = 64) : m_pauseCount(1), m_maxPauseCount(maxPauseCount){}
+
+	void Pause(){
+		if(m_pauseCount > m_maxPauseCount){
+			std::this_thread::yield();
+			return;
+		}
+
+		for(uint32_t i=0; i<m_pauseCount; i++)
+			RGE_CPU_RELAX();
+		m_pauseCount <<= 1;
+	}
+
+// true -     ,   
+	bool IsSaturated() const{
+		return m_pauseCount > m_maxPauseCount;
+	}
+
+	void Reset(){
+		m_pauseCount = 1;
+	}
+
+private:
+	uint32_t	m_pauseCount;
+	uint32_t	m_maxPauseCount;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+/****************************************************************
+*	     ( ,	*
+*	 API,  ):   ,		*
+*	   ,     		*
+*	 (  GetMaxThreadCount);   	*
+*	     ;  	*
+*	      						*
+****************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ThreadManager.h"
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class BlockingRegion{
+private:
+	BlockingRegion(const BlockingRegion&) = delete;
+	BlockingRegion& operator=(const BlockingRegion&) = delete;
+
+public:
+	BlockingRegion() : m_blocked(ThreadManager::Instance().EnterBlockingRegion()){}
+
+	~BlockingRegion(){
+		ThreadManager::Instance().LeaveBlockingRegion(m_blocked);
+	}
+
+	bool IsCompensated() const{									//    
+		return m_blocked != nullptr;
+	}
+
+private:
+	ThreadPtr	m_blocked;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "BravoRWLock.h"
+#include "Backoff.h"
+#include <chrono>
+#include <functional>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+BravoRWLock::ReaderRow		BravoRWLock::s_readers[BravoRWLock::MAX_READER_THREADS];
+
+
+//======================================
+//   , 
+//      
+//======================================
+class BravoRWLock::RowHolder{
+public:
+	RowHolder() : m_row(nullptr){
+		for(uint32_t i=0; i<MAX_READER_THREADS; i++){
+			bool expected = false;
+			if(s_rowUsed[i].compare_exchange_strong(expected, true)){
+				m_row = &s_readers[i];
+				m_index = i;
+				return;
+			}
+		}
+	}
+
+//   m_row == nullptr:   ,  ,   
+	~RowHolder(){
+		if(m_row)
+			s_rowUsed[m_index].store(false);
+		m_row = nullptr;
+	}
+
+	ReaderRow* GetRow() const{
+		return m_row;
+	}
+
+private:
+	static std::atomic_bool		s_rowUsed[MAX_READER_THREADS];
+
+	ReaderRow*					m_row;
+	uint32_t					m_index;
+};
+
+std::atomic_bool	BravoRWLock::RowHolder::s_rowUsed[BravoRWLock::MAX_READER_THREADS];
+
+
+BravoRWLock::BravoRWLock(){
+	m_readBias.store(true);
+	m_inhibitUntil.store(0);
+}
+
+BravoRWLock::~BravoRWLock(){
+}
+
+
+void BravoRWLock::LockRead(){
+	if(m_readBias.load(std::memory_order_acquire)){
+		std::atomic<const BravoRWLock*>* slot = GetReaderSlot();
+		const BravoRWLock* expected = nullptr;
+		if(slot && slot->compare_exchange_strong(expected, this)){
+			if(m_readBias.load())								//    ,    
+				return;
+			slot->store(nullptr, std::memory_order_release);
+		}
+	}
+
+	m_lock.LockRead();
+	if(!m_readBias.load(std::memory_order_relaxed) && Now() >= m_inhibitUntil.load(std::memory_order_relaxed))
+		m_readBias.store(true);
+}
+
+//        ,    this   
+void BravoRWLock::UnlockRead(){
+	std::atomic<const BravoRWLock*>* slot = GetReaderSlot();
+	if(slot && slot->load(std::memory_order_relaxed) == this){
+		slot->store(nullptr, std::memory_order_release);
+		return;
+	}
+
+	m_lock.UnlockRead();
+}
+
+
+void BravoRWLock::LockWrite(){
+	m_lock.LockWrite();
+	if(m_readBias.load(std::memory_order_relaxed))
+		RevokeReadBias();
+}
+
+void BravoRWLock::UnlockWrite(){
+	m_lock.UnlockWrite();
+}
+
+
+bool BravoRWLock::IsReadBiased() const{
+	return m_readBias;
+}
+
+
+std::atomic<const BravoRWLock*>* BravoRWLock::GetReaderSlot() const{
+	static thread_local RowHolder	holder;
+
+	ReaderRow* row = holder.GetRow();
+	if(row == nullptr)
+		return nullptr;
+
+	size_t hash = std::hash<const void*>()(this);
+	return &row->slots[(hash ^ (hash >> 6)) % SLOTS_PER_THREAD];
+}
+
+void BravoRWLock::RevokeReadBias(){
+	m_readBias.store(false);
+
+	int64_t start = Now();
+	for(uint32_t i=0; i<MAX_READER_THREADS; i++){
+		for(uint32_t j=0; j<SLOTS_PER_THREAD; j++){
+			Backoff backoff;
+			while(s_readers[i].slots[j].load(std::memory_order_acquire) == this)
+				backoff.Pause();
+		}
+	}
+
+	int64_t now = Now();
+	m_inhibitUntil.store(now + (now - start) * INHIBIT_MULTIPLIER, std::memory_order_relaxed);
+}
+
+
+int64_t BravoRWLock::Now(){
+	return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+/****************************************************************************
+*	  -    (BRAVO):		*
+*	     ,   			*
+*	  ,       	*
+*	 -, ..    ;						*
+*	    ,     			*
+*	 ;      ,  		*
+*	,    (  		*
+*	      );							*
+*	     RWSpinlock								*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "RWSpinlock.h"
+#include "../Platform/Settings.h"
+#include <atomic>
+#include <cstdint>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class KERNEL_API BravoRWLock : public IReadWriteLock{
+private:
+	static const uint32_t	MAX_READER_THREADS	= 256;					//        
+	static const uint32_t	SLOTS_PER_THREAD	= RGE_CACHE_LINE_SIZE / sizeof(void*);	//      -
+	static const uint32_t	INHIBIT_MULTIPLIER	= 9;					//           
+
+	struct alignas(RGE_CACHE_LINE_SIZE) ReaderRow{
+		std::atomic<const BravoRWLock*>		slots[SLOTS_PER_THREAD];
+	};
+
+	class RowHolder;
+
+private:
+	BravoRWLock(const BravoRWLock&) = delete;
+	BravoRWLock& operator=(const BravoRWLock&) = delete;
+
+public:
+	BravoRWLock();
+	~BravoRWLock();
+
+	void LockRead();
+	void UnlockRead();
+
+	void LockWrite();
+	void UnlockWrite();
+
+	bool IsReadBiased() const;
+
+private:
+	std::atomic<const BravoRWLock*>*	GetReaderSlot() const;		// nullptr,       
+	void								RevokeReadBias();
+
+	static int64_t						Now();
+
+private:
+	static ReaderRow					s_readers[MAX_READER_THREADS];
+
+	std::atomic_bool					m_readBias;
+	std::atomic<int64_t>				m_inhibitUntil;				//         
+	RWSpinlock							m_lock;
+};
+
+}
+}
\ No newline at end of file
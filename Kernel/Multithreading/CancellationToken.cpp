@@ -0,0 +1,112 @@
+#include "CancellationToken.h"
+#include "../Exception/Exception.h"
+#include <mutex>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+//    :         
+static void CancelState(CancellationState& state){
+	if(state.cancelled.exchange(true))
+		return;
+
+	std::vector< std::pair<uint64_t, std::function<void()>> > callbacks;
+	{
+		std::lock_guard<Spinlock> guard(state.lock);
+		callbacks.swap(state.callbacks);
+	}
+
+	for(auto& callback : callbacks)
+		callback.second();
+}
+
+
+CancellationToken::CancellationToken(){}
+
+CancellationToken::CancellationToken(const std::shared_ptr<CancellationState>& state) : m_state(state){}
+
+
+bool CancellationToken::IsCancelled() const{
+	return m_state && m_state->cancelled.load(std::memory_order_acquire);
+}
+
+bool CancellationToken::CanBeCancelled() const{
+	return m_state != nullptr;
+}
+
+void CancellationToken::ThrowIfCancelled() const{
+	if(IsCancelled())
+		RGE_Throw(Exception::Cancelled, "Operation was cancelled");
+}
+
+
+uint64_t CancellationToken::Register(std::function<void()> callback) const{
+	if(!m_state)
+		return 0;
+
+	{
+		std::lock_guard<Spinlock> guard(m_state->lock);
+		if(!m_state->cancelled.load()){
+			uint64_t id = m_state->nextID++;
+			m_state->callbacks.emplace_back(id, std::move(callback));
+			return id;
+		}
+	}
+
+	callback();
+	return 0;
+}
+
+bool CancellationToken::Unregister(uint64_t id) const{
+	if(!m_state || id == 0)
+		return false;
+
+	std::lock_guard<Spinlock> guard(m_state->lock);
+	auto& callbacks = m_state->callbacks;
+	for(auto it = callbacks.begin(); it != callbacks.end(); ++it){
+		if(it->first == id){
+			callbacks.erase(it);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+CancellationSource::CancellationSource() :
+	m_state(std::make_shared<CancellationState>()),
+	m_parentRegistration(0)
+{}
+
+//    ,     
+CancellationSource::CancellationSource(const CancellationToken& parent) :
+	m_state(std::make_shared<CancellationState>()),
+	m_parent(parent),
+	m_parentRegistration(0)
+{
+	std::shared_ptr<CancellationState> state = m_state;
+	m_parentRegistration = m_parent.Register([state](){ CancelState(*state); });
+}
+
+CancellationSource::~CancellationSource(){
+	m_parent.Unregister(m_parentRegistration);
+}
+
+
+void CancellationSource::Cancel(){
+	CancelState(*m_state);
+}
+
+bool CancellationSource::IsCancelled() const{
+	return m_state->cancelled.load(std::memory_order_acquire);
+}
+
+CancellationToken CancellationSource::GetToken() const{
+	return CancellationToken(m_state);
+}
+
+}
+}
\ No newline at end of file
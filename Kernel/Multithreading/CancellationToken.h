@@ -0,0 +1,80 @@
+/****************************************************************************
+*	 : CancellationSource ,  	*
+*	CancellationToken; ,    ,			*
+*	   ;    		*
+*	  ,  Cancel ( ,    )		*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Spinlock.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+struct CancellationState{
+	CancellationState() : nextID(1){
+		cancelled.store(false);
+	}
+
+	std::atomic_bool										cancelled;
+	Spinlock												lock;
+	std::vector< std::pair<uint64_t, std::function<void()>> >	callbacks;
+	uint64_t												nextID;
+};
+
+
+class KERNEL_API CancellationToken{
+	friend class CancellationSource;
+
+public:
+	CancellationToken();									// ,     
+
+	bool			IsCancelled() const;
+	bool			CanBeCancelled() const;
+	void			ThrowIfCancelled() const;				//  Exception::Cancelled
+
+// 0 -    (  )      (  );
+//       Unregister,     ,  
+	uint64_t		Register(std::function<void()> callback) const;
+	bool			Unregister(uint64_t id) const;
+
+private:
+	CancellationToken(const std::shared_ptr<CancellationState>& state);
+
+private:
+	std::shared_ptr<CancellationState>	m_state;
+};
+
+
+class KERNEL_API CancellationSource{
+private:
+	CancellationSource(const CancellationSource&) = delete;
+	CancellationSource& operator=(const CancellationSource&) = delete;
+
+public:
+	CancellationSource();
+	explicit CancellationSource(const CancellationToken& parent);	//     parent
+	~CancellationSource();
+
+	void				Cancel();
+	bool				IsCancelled() const;
+	CancellationToken	GetToken() const;
+
+private:
+	std::shared_ptr<CancellationState>	m_state;
+	CancellationToken					m_parent;
+	uint64_t							m_parentRegistration;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+/****************************************************************************
+*	  ; Wait    		*
+*			(    ,    );			*
+*	  Wait       ;	*
+*	Wait ,    Done  		*
+*	 ,   Wait   					*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "AtomicWait.h"
+#include "FiberScheduler.h"
+#include "Continuation.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class CompletionCounter{
+private:
+	static const int64_t	SIGNALING = int64_t(1) << 62;		//  Done  ;    
+
+	CompletionCounter(const CompletionCounter&) = delete;
+	CompletionCounter& operator=(const CompletionCounter&) = delete;
+
+public:
+	CompletionCounter(){
+		m_count.store(0);
+	}
+
+	void Add(uint32_t count = 1){
+		m_count.fetch_add(count);
+	}
+
+//      SIGNALING:   -   Done  
+	void Done(){
+		int64_t count = m_count.load(std::memory_order_relaxed);
+		while(!m_count.compare_exchange_weak(count, count == 1 ? SIGNALING : count - 1));
+		if(count != 1)
+			return;
+
+		m_count.notify_all();
+		std::atomic_thread_fence(std::memory_order_seq_cst);			//      AddContinuation
+		m_continuations.Drain();
+		m_count.fetch_sub(SIGNALING);
+	}
+
+//   SIGNALING,   :      
+	void Wait() const{
+		FiberScheduler* fibers = FiberScheduler::Current();
+		bool inFiber = fibers != nullptr && fibers->IsInFiber();
+
+		int64_t count = m_count.load(std::memory_order_acquire);
+		while(count != 0){
+			if(count & SIGNALING){
+				if(inFiber)	fibers->Reschedule();
+				else		std::this_thread::yield();
+			}
+			else if(inFiber)
+				fibers->Await([this](Continuation* cont){ return AddContinuation(cont); });
+			else
+				m_spin.Wait(m_count, count);
+			count = m_count.load(std::memory_order_acquire);
+		}
+	}
+
+	bool IsCompleted() const{
+		return m_count.load(std::memory_order_acquire) == 0;
+	}
+
+	int64_t GetCount() const{
+		return m_count.load(std::memory_order_relaxed) & ~SIGNALING;
+	}
+
+private:
+//     ,      :
+//    ,  Done  ,   
+	bool AddContinuation(Continuation* cont) const{
+		m_continuations.TryAdd(cont);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if((m_count.load(std::memory_order_relaxed) & ~SIGNALING) == 0)
+			m_continuations.Drain();
+		return true;
+	}
+
+private:
+	std::atomic<int64_t>		m_count;
+	mutable AdaptiveSpin		m_spin;
+	mutable ContinuationList	m_continuations;			// ,  
+};
+
+}
+}
\ No newline at end of file
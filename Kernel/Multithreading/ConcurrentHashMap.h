@@ -0,0 +1,440 @@
+/****************************************************************************
+*		 -,    (shards);		*
+*	        ;		*
+*	   K  V    		*
+*	(     ),  		*
+*	 -      ;						*
+*	        		*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "RWSpinlock.h"
+#include "../Platform/Settings.h"
+#include "../Memory/PoolAllocator.h"
+#include "../Memory/Adapter.h"
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class ConcurrentHashMap{
+private:
+	struct Node{
+		Node(const K& _key, const V& _value, size_t _hash) : key(_key), value(_value), hash(_hash){
+			next.store(nullptr, std::memory_order_relaxed);
+		}
+
+		K						key;
+		V						value;
+		size_t					hash;
+		std::atomic<Node*>		next;
+	};
+
+//        :      
+	struct BucketArray{
+		BucketArray(size_t count) : mask(count - 1), prev(nullptr){
+			buckets = new std::atomic<Node*>[count];
+			for(size_t i=0; i<count; i++)
+				buckets[i].store(nullptr, std::memory_order_relaxed);
+		}
+		~BucketArray(){
+			delete[] buckets;
+		}
+
+		std::atomic<Node*>*		buckets;
+		size_t					mask;
+		BucketArray*			prev;
+	};
+
+	struct Shard{
+		Shard() : freeNodes(nullptr), allocator(nullptr), pool(nullptr){
+			version.store(0, std::memory_order_relaxed);
+			table.store(nullptr, std::memory_order_relaxed);
+			size.store(0, std::memory_order_relaxed);
+		}
+
+		RWSpinlock						lock;
+		std::atomic<uint32_t>			version;			// ,    
+		std::atomic<BucketArray*>		table;
+		std::atomic<size_t>				size;
+		Node*							freeNodes;			//      (   )
+		Memory::IAllocator*				allocator;
+		Memory::PoolAllocator<Node>*	pool;				//  ,    
+		uint8_t							pad[RGE_CACHE_LINE_SIZE];
+	};
+
+//      ;     
+	class WriteSection{
+	public:
+		WriteSection(Shard& shard) : m_shard(shard){
+			m_shard.version.store(m_shard.version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+		~WriteSection(){
+			m_shard.version.store(m_shard.version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+	private:
+		Shard&		m_shard;
+	};
+
+//             
+	typedef std::integral_constant<bool, std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value>	OptimisticRead;
+
+private:
+	ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+	ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+public:
+// shardCount    ; allocator == nullptr -     
+	explicit ConcurrentHashMap(uint32_t shardCount = 16, Memory::IAllocator* allocator = nullptr, uint32_t bucketsPerShard = 16){
+		uint32_t realShardCount = 1;
+		m_shardBits = 0;
+		while(realShardCount < shardCount){
+			realShardCount <<= 1;
+			m_shardBits++;
+		}
+
+		size_t bucketCount = 2;
+		while(bucketCount < bucketsPerShard)
+			bucketCount <<= 1;
+
+		m_shardCount = realShardCount;
+		m_shards	 = new Shard[m_shardCount];
+		for(uint32_t i=0; i<m_shardCount; i++){
+			Shard& shard = m_shards[i];
+			if(allocator == nullptr){
+				shard.pool		= new Memory::PoolAllocator<Node>(static_cast<uint32_t>(bucketCount));
+				shard.allocator = shard.pool;
+			}
+			else
+				shard.allocator = allocator;
+			shard.table.store(new BucketArray(bucketCount), std::memory_order_relaxed);
+		}
+	}
+
+	~ConcurrentHashMap(){
+		clear();
+
+		for(uint32_t i=0; i<m_shardCount; i++){
+			Shard& shard = m_shards[i];
+			while(shard.freeNodes != nullptr){
+				Node* node = shard.freeNodes;
+				shard.freeNodes = node->next.load(std::memory_order_relaxed);
+				Memory::Delete(*shard.allocator, node);
+			}
+
+			BucketArray* table = shard.table.load();
+			while(table != nullptr){
+				BucketArray* prev = table->prev;
+				delete table;
+				table = prev;
+			}
+
+			delete shard.pool;
+		}
+		delete[] m_shards;
+	}
+
+
+// false,       (  )
+	bool insert(const K& key, const V& value){
+		size_t hash  = Mix(m_hasher(key));
+		Shard& shard = GetShard(hash);
+
+		WriteLockGuard lock(shard.lock);
+		if(FindNode(shard, key, hash) != nullptr)
+			return false;
+
+		WriteSection section(shard);
+		AddNode(shard, key, value, hash);
+		return true;
+	}
+
+// true,    , false -    
+	bool insert_or_assign(const K& key, const V& value){
+		size_t hash  = Mix(m_hasher(key));
+		Shard& shard = GetShard(hash);
+
+		WriteLockGuard lock(shard.lock);
+		WriteSection section(shard);
+		Node* node = FindNode(shard, key, hash);
+		if(node != nullptr){
+			node->value = value;
+			return false;
+		}
+
+		AddNode(shard, key, value, hash);
+		return true;
+	}
+
+//    (first - , second - );      ;
+//    
+	template <class Iterator>
+	size_t insert_range(Iterator first, Iterator last){
+		std::vector< std::pair<size_t, Iterator> > elems;
+		for(Iterator it = first; it != last; ++it)
+			elems.emplace_back(Mix(m_hasher(it->first)), it);
+
+		std::sort(elems.begin(), elems.end(), [this](const std::pair<size_t, Iterator>& lhs, const std::pair<size_t, Iterator>& rhs){
+			return GetShardIndex(lhs.first) < GetShardIndex(rhs.first);
+		});
+
+		size_t inserted = 0;
+		size_t i = 0;
+		while(i < elems.size()){
+			uint32_t shardIndx = GetShardIndex(elems[i].first);
+			Shard&	 shard	   = m_shards[shardIndx];
+
+			WriteLockGuard lock(shard.lock);
+			WriteSection   section(shard);
+			for(; i < elems.size() && GetShardIndex(elems[i].first) == shardIndx; i++){
+				const size_t hash = elems[i].first;
+				if(FindNode(shard, elems[i].second->first, hash) == nullptr){
+					AddNode(shard, elems[i].second->first, elems[i].second->second, hash);
+					inserted++;
+				}
+			}
+		}
+
+		return inserted;
+	}
+
+	bool erase(const K& key){
+		size_t hash  = Mix(m_hasher(key));
+		Shard& shard = GetShard(hash);
+
+		WriteLockGuard lock(shard.lock);
+		BucketArray* table = shard.table.load(std::memory_order_relaxed);
+		std::atomic<Node*>* link = &table->buckets[hash & table->mask];
+
+		for(Node* node = link->load(std::memory_order_relaxed); node != nullptr; node = link->load(std::memory_order_relaxed)){
+			if(node->hash == hash && m_equal(node->key, key)){
+				WriteSection section(shard);
+				link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+				shard.size.fetch_sub(1, std::memory_order_relaxed);
+				FreeNode(shard, node, OptimisticRead());
+				return true;
+			}
+			link = &node->next;
+		}
+		return false;
+	}
+
+	bool find(const K& key, V* value) const{
+		size_t hash = Mix(m_hasher(key));
+		return Find(GetShard(hash), key, hash, value, OptimisticRead());
+	}
+
+	bool contains(const K& key) const{
+		V value;
+		return find(key, &value);
+	}
+
+//    ,  oper(key, value)  true;        
+	template <class Operation>
+	Operation for_each(Operation oper) const{
+		for(uint32_t i=0; i<m_shardCount; i++){
+			Shard& shard = m_shards[i];
+			ReadLockGuard lock(shard.lock);
+
+			BucketArray* table = shard.table.load(std::memory_order_relaxed);
+			for(size_t b=0; b<=table->mask; b++)
+				for(Node* node = table->buckets[b].load(std::memory_order_relaxed); node != nullptr; node = node->next.load(std::memory_order_relaxed))
+					if(!oper(static_cast<const K&>(node->key), static_cast<const V&>(node->value)))
+						return oper;
+		}
+		return oper;
+	}
+
+	void clear(){
+		for(uint32_t i=0; i<m_shardCount; i++){
+			Shard& shard = m_shards[i];
+			WriteLockGuard lock(shard.lock);
+			WriteSection   section(shard);
+
+			BucketArray* table = shard.table.load(std::memory_order_relaxed);
+			for(size_t b=0; b<=table->mask; b++){
+				Node* node = table->buckets[b].exchange(nullptr, std::memory_order_release);
+				while(node != nullptr){
+					Node* next = node->next.load(std::memory_order_relaxed);
+					FreeNode(shard, node, OptimisticRead());
+					node = next;
+				}
+			}
+			shard.size.store(0, std::memory_order_relaxed);
+		}
+	}
+
+
+	size_t size() const{
+		size_t size = 0;
+		for(uint32_t i=0; i<m_shardCount; i++)
+			size += m_shards[i].size.load(std::memory_order_relaxed);
+		return size;
+	}
+
+	bool empty() const{
+		return size() == 0;
+	}
+
+	uint32_t shard_count() const{
+		return m_shardCount;
+	}
+
+private:
+//   ( fmix64): std::hash    ,   
+//   ,  -  ;           
+	static size_t Mix(size_t hash){
+		uint64_t h = hash;
+		h ^= h >> 33;
+		h *= 0xFF51AFD7ED558CCDull;
+		h ^= h >> 33;
+		h *= 0xC4CEB9FE1A85EC53ull;
+		h ^= h >> 33;
+		return static_cast<size_t>(h);
+	}
+
+	uint32_t GetShardIndex(size_t hash) const{
+		return m_shardBits == 0 ? 0 : static_cast<uint32_t>(hash >> (sizeof(size_t)*8 - m_shardBits));
+	}
+
+	Shard& GetShard(size_t hash) const{
+		return m_shards[GetShardIndex(hash)];
+	}
+
+//    
+	Node* FindNode(Shard& shard, const K& key, size_t hash) const{
+		BucketArray* table = shard.table.load(std::memory_order_relaxed);
+		for(Node* node = table->buckets[hash & table->mask].load(std::memory_order_relaxed); node != nullptr; node = node->next.load(std::memory_order_relaxed))
+			if(node->hash == hash && m_equal(node->key, key))
+				return node;
+		return nullptr;
+	}
+
+//      WriteSection
+	void AddNode(Shard& shard, const K& key, const V& value, size_t hash){
+		Node* node = AllocateNode(shard, key, value, hash);
+
+		if(shard.size.load(std::memory_order_relaxed) + 1 > shard.table.load(std::memory_order_relaxed)->mask + 1)
+			Grow(shard);
+
+		BucketArray* table = shard.table.load(std::memory_order_relaxed);
+		std::atomic<Node*>& bucket = table->buckets[hash & table->mask];
+		node->next.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		bucket.store(node, std::memory_order_release);
+		shard.size.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void Grow(Shard& shard){
+		BucketArray* oldTable = shard.table.load(std::memory_order_relaxed);
+		BucketArray* newTable = new BucketArray((oldTable->mask + 1) * 2);
+
+		for(size_t b=0; b<=oldTable->mask; b++){
+			Node* node = oldTable->buckets[b].load(std::memory_order_relaxed);
+			while(node != nullptr){
+				Node* next = node->next.load(std::memory_order_relaxed);
+				std::atomic<Node*>& bucket = newTable->buckets[node->hash & newTable->mask];
+				node->next.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				bucket.store(node, std::memory_order_relaxed);
+				node = next;
+			}
+		}
+
+		newTable->prev = oldTable;
+		shard.table.store(newTable, std::memory_order_release);
+	}
+
+	Node* AllocateNode(Shard& shard, const K& key, const V& value, size_t hash){
+		if(shard.freeNodes != nullptr){
+			Node* node		= shard.freeNodes;
+			shard.freeNodes = node->next.load(std::memory_order_relaxed);
+			return new(node) Node(key, value, hash);
+		}
+		return Memory::CreateNew<Node>(*shard.allocator, key, value, hash);
+	}
+
+//     ,     
+	void FreeNode(Shard& shard, Node* node, std::true_type){
+		node->next.store(shard.freeNodes, std::memory_order_relaxed);
+		shard.freeNodes = node;
+	}
+
+	void FreeNode(Shard& shard, Node* node, std::false_type){
+		Memory::Delete(*shard.allocator, node);
+	}
+
+//   ;  ,         
+	bool Find(Shard& shard, const K& key, size_t hash, V* value, std::true_type) const{
+		typename std::aligned_storage<sizeof(K), alignof(K)>::type keyCopy;
+		typename std::aligned_storage<sizeof(V), alignof(V)>::type valueCopy;
+
+		while(true){
+			uint32_t version = shard.version.load(std::memory_order_acquire);
+			if(version & 1){
+				std::this_thread::yield();
+				continue;
+			}
+
+			BucketArray* table = shard.table.load(std::memory_order_acquire);
+			Node* node = table->buckets[hash & table->mask].load(std::memory_order_acquire);
+			bool  retry = false;
+
+			while(node != nullptr){
+				bool sameHash = node->hash == hash;
+				if(sameHash){
+					memcpy(&keyCopy, &node->key, sizeof(K));
+					memcpy(&valueCopy, &node->value, sizeof(V));
+				}
+				Node* next = node->next.load(std::memory_order_acquire);
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if(shard.version.load(std::memory_order_relaxed) != version){
+					retry = true;
+					break;
+				}
+
+				if(sameHash && m_equal(*reinterpret_cast<const K*>(&keyCopy), key)){
+					*value = *reinterpret_cast<const V*>(&valueCopy);
+					return true;
+				}
+				node = next;
+			}
+
+			if(!retry)
+				return false;
+		}
+	}
+
+	bool Find(Shard& shard, const K& key, size_t hash, V* value, std::false_type) const{
+		ReadLockGuard lock(shard.lock);
+		Node* node = FindNode(shard, key, hash);
+		if(node == nullptr)
+			return false;
+
+		*value = node->value;
+		return true;
+	}
+
+private:
+	Shard*			m_shards;
+	uint32_t		m_shardCount;
+	uint32_t		m_shardBits;
+	Hash			m_hasher;
+	KeyEqual		m_equal;
+};
+
+}
+}
\ No newline at end of file
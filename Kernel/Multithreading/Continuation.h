@@ -0,0 +1,93 @@
+/****************************************************************************
+*	 ,    ( ,	*
+*	,  -);     		*
+*	(  awaiter'   ),   			*
+*	;  Close    - TryAdd 		*
+*	false,    										*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include <atomic>
+#include <cstdint>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+struct Continuation{
+	typedef void (*Callback)(Continuation* cont);
+
+	Continuation(Callback cb) : next(nullptr), callback(cb){}
+
+	Continuation*	next;
+	Callback		callback;
+};
+
+
+class ContinuationList{
+private:
+	ContinuationList(const ContinuationList&) = delete;
+	ContinuationList& operator=(const ContinuationList&) = delete;
+
+public:
+	ContinuationList(){
+		m_head.store(nullptr);
+	}
+
+// false,    
+	bool TryAdd(Continuation* cont){
+		Continuation* head = m_head.load(std::memory_order_acquire);
+		do{
+			if(head == Closed())
+				return false;
+			cont->next = head;
+		} while(!m_head.compare_exchange_weak(head, cont, std::memory_order_acq_rel, std::memory_order_acquire));
+		return true;
+	}
+
+//   ;       callback
+	void Close(){
+		Continuation* cont = m_head.exchange(Closed(), std::memory_order_acq_rel);
+		if(cont == Closed())							//   (   SetState)
+			return;
+
+		while(cont != nullptr){
+			Continuation* next = cont->next;
+			cont->callback(cont);
+			cont = next;
+		}
+	}
+
+//    (CompletionCounter):    ,   
+	void Drain(){
+		Continuation* cont = m_head.exchange(nullptr, std::memory_order_acq_rel);
+		while(cont != nullptr){
+			Continuation* next = cont->next;
+			cont->callback(cont);
+			cont = next;
+		}
+	}
+
+// ,    ( )
+	void Reset(){
+		m_head.store(nullptr, std::memory_order_release);
+	}
+
+	bool IsClosed() const{
+		return m_head.load(std::memory_order_acquire) == Closed();
+	}
+
+private:
+	static Continuation* Closed(){
+		return reinterpret_cast<Continuation*>( static_cast<uintptr_t>(1) );
+	}
+
+private:
+	std::atomic<Continuation*>	m_head;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,495 @@
+/****************************************************************************
+*	-: Coroutine<T> f(...){ ...; co_await x; ...; co_return v; }	*
+*	 :  ThreadManager::Spawn (  	*
+*	),  co_await    (  )	*
+*	  Wait/GetResult (   );				*
+*	    :   			*
+*	 ,   ;				*
+*	   TaskPool   IAllocator,  		*
+*	: f(std::allocator_arg, allocator, ...);						*
+*	Yield -   , Delay -    	*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ITask.h"
+#include "IScheduler.h"
+#include "Continuation.h"
+#include "CompletionCounter.h"
+#include "AtomicWait.h"
+#include "TaskPool.h"
+#include "../Memory/IAllocator.h"
+#include "../Exception/Exception.h"
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+//======================================
+// ,  
+//   ;  
+//     ,
+//   
+//======================================
+class ResumeContinuation : public Continuation{
+public:
+	ResumeContinuation() : Continuation(&Resume), m_scheduler(nullptr), m_priority(TP_NORMAL){}
+
+protected:
+	template <class Promise>
+	void Bind(std::coroutine_handle<Promise> handle);
+
+	static void Resume(Continuation* cont){
+		ResumeContinuation* self = static_cast<ResumeContinuation*>(cont);
+		std::coroutine_handle<> handle = self->m_handle;			//       
+		if(self->m_scheduler)
+			self->m_scheduler->Schedule(handle, self->m_priority);
+		else
+			handle.resume();
+	}
+
+protected:
+	std::coroutine_handle<>		m_handle;
+	IScheduler*					m_scheduler;
+	TaskPriority				m_priority;
+};
+
+
+//======================================
+//    :
+// , ,  
+//======================================
+class PromiseBase{
+	friend class ThreadManager;
+	template <typename T> friend class Coroutine;
+private:
+	static const size_t		FRAME_HEADER_SIZE = 16;		//    - ,    
+
+	struct FinalAwaiter{
+		bool await_ready() const noexcept{ return false; }
+		template <class Promise>
+		void await_suspend(std::coroutine_handle<Promise> handle) noexcept{
+			handle.promise().Complete();
+		}
+		void await_resume() const noexcept{}
+	};
+
+	PromiseBase(const PromiseBase&) = delete;
+	PromiseBase& operator=(const PromiseBase&) = delete;
+
+public:
+	class Awaiter;
+
+	PromiseBase() : m_scheduler(nullptr), m_priority(TP_NORMAL), m_completion(nullptr){
+		m_state.store(TS_QUEUED);
+		m_refs.store(2);										//  (Coroutine)  
+	}
+
+	static void* operator new(size_t size){
+		return AllocateFrame(size, nullptr);
+	}
+	template <class... Args>
+	static void* operator new(size_t size, std::allocator_arg_t, Memory::IAllocator& allocator, Args&...){
+		return AllocateFrame(size, &allocator);
+	}
+	template <class Owner, class... Args>
+	static void* operator new(size_t size, Owner&, std::allocator_arg_t, Memory::IAllocator& allocator, Args&...){
+		return AllocateFrame(size, &allocator);				//  -  
+	}
+	static void operator delete(void* ptr){
+		uint8_t* frame = static_cast<uint8_t*>(ptr) - FRAME_HEADER_SIZE;
+		Memory::IAllocator* allocator = *reinterpret_cast<Memory::IAllocator**>(frame);
+		if(allocator)	allocator->Deallocate(frame);
+		else			TaskPool::Deallocate(frame);
+	}
+
+	std::suspend_always initial_suspend() const noexcept{
+		return std::suspend_always();
+	}
+	FinalAwaiter final_suspend() const noexcept{
+		return FinalAwaiter();
+	}
+	void unhandled_exception(){
+		m_exception = std::current_exception();
+	}
+
+
+	TaskState GetState() const{
+		return m_state.load(std::memory_order_acquire);
+	}
+
+	IScheduler* GetScheduler() const{
+		return m_scheduler;
+	}
+
+	TaskPriority GetPriority() const{
+		return m_priority;
+	}
+
+//      -        
+	void Wait(){
+		if(TryStart())
+			m_handle.resume();
+
+		TaskState state = m_state.load(std::memory_order_acquire);
+		while(state < TS_READY){
+			m_spin.Wait(m_state, state);
+			state = m_state.load(std::memory_order_acquire);
+		}
+	}
+
+	void RethrowIfFailed() const{
+		if(m_exception)
+			std::rethrow_exception(m_exception);
+	}
+
+protected:
+	void SetHandle(std::coroutine_handle<> handle){
+		m_handle = handle;
+	}
+
+// false,    
+	bool TryStart(){
+		TaskState expected = TS_QUEUED;
+		return m_state.compare_exchange_strong(expected, TS_PROCESSING);
+	}
+
+	void Start(IScheduler* scheduler, TaskPriority priority, CompletionCounter* completion){
+		RGE_Assert(GetState() == TS_QUEUED, Exception::WrongState, "Coroutine is already started");
+
+		m_scheduler	 = scheduler;
+		m_priority	 = priority;
+		m_completion = completion;
+		if(m_completion)	m_completion->Add();
+
+		if(TryStart())
+			m_scheduler->Schedule(m_handle, m_priority);
+	}
+
+	void Complete(){
+		CompletionCounter* completion = m_completion;		//  Release     
+
+		m_state.store(TS_READY, std::memory_order_release);
+		m_state.notify_all();
+		m_continuations.Close();
+		if(completion)	completion->Done();
+		Release();
+	}
+
+//  ;    
+	void ReleaseOwner(){
+		TaskState expected = TS_QUEUED;
+		if(m_state.compare_exchange_strong(expected, TS_DISCARDED))
+			m_handle.destroy();
+		else
+			Release();
+	}
+
+	void Release(){
+		if(m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			m_handle.destroy();
+	}
+
+	static void* AllocateFrame(size_t size, Memory::IAllocator* allocator){
+		uint8_t* frame = static_cast<uint8_t*>( allocator ? allocator->Allocate(static_cast<uint32_t>(size + FRAME_HEADER_SIZE))
+														  : TaskPool::Allocate(size + FRAME_HEADER_SIZE) );
+		if(frame == nullptr)
+			throw std::bad_alloc();
+
+		*reinterpret_cast<Memory::IAllocator**>(frame) = allocator;
+		return frame + FRAME_HEADER_SIZE;
+	}
+
+protected:
+	std::coroutine_handle<>			m_handle;
+	std::atomic<TaskState>			m_state;
+	std::atomic<uint32_t>			m_refs;
+	ContinuationList				m_continuations;		// ,   
+	AdaptiveSpin					m_spin;					// Wait   
+
+	IScheduler*						m_scheduler;
+	TaskPriority					m_priority;
+	CompletionCounter*				m_completion;
+	std::exception_ptr				m_exception;
+};
+
+
+template <class Promise>
+void ResumeContinuation::Bind(std::coroutine_handle<Promise> handle){
+	m_handle = handle;
+	if constexpr(std::is_base_of<PromiseBase, Promise>::value){
+		m_scheduler = handle.promise().GetScheduler();
+		m_priority	= handle.promise().GetPriority();
+	}
+}
+
+
+//======================================
+//    ;
+//    
+//   
+//======================================
+class PromiseBase::Awaiter : public ResumeContinuation{
+public:
+	Awaiter(PromiseBase* promise) : m_promise(promise){}
+
+	bool await_ready() const{
+		return m_promise->GetState() >= TS_READY;
+	}
+
+	template <class Promise>
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle){
+		Bind(handle);
+
+		bool start = m_promise->TryStart();
+		if(start){
+			m_promise->m_scheduler	= m_scheduler;
+			m_promise->m_priority	= m_priority;
+		}
+
+		if(!m_promise->m_continuations.TryAdd(this))
+			return handle;								//  
+		return start ? m_promise->m_handle : std::noop_coroutine();
+	}
+
+protected:
+	PromiseBase*	m_promise;
+};
+
+
+template <typename T>
+class Coroutine{
+	friend class ThreadManager;
+public:
+	class promise_type : public PromiseBase{
+	public:
+		Coroutine get_return_object(){
+			SetHandle( std::coroutine_handle<promise_type>::from_promise(*this) );
+			return Coroutine(this);
+		}
+
+		template <class U>
+		void return_value(U&& val){
+			m_result.emplace(std::forward<U>(val));
+		}
+
+		T& GetResult(){
+			Wait();
+			RethrowIfFailed();
+			return *m_result;
+		}
+
+	private:
+		std::optional<T>	m_result;
+	};
+
+private:
+	class Awaiter : public PromiseBase::Awaiter{
+	public:
+		Awaiter(promise_type* promise, bool moveResult) : PromiseBase::Awaiter(promise), m_moveResult(moveResult){}
+
+		T await_resume(){
+			T& result = static_cast<promise_type*>(m_promise)->GetResult();
+			if(m_moveResult)
+				return std::move(result);
+			return result;
+		}
+
+	private:
+		bool	m_moveResult;
+	};
+
+	Coroutine(const Coroutine&) = delete;
+	Coroutine& operator=(const Coroutine&) = delete;
+
+	explicit Coroutine(promise_type* promise) : m_promise(promise){}
+
+public:
+	Coroutine(Coroutine&& co) : m_promise(co.m_promise){
+		co.m_promise = nullptr;
+	}
+	~Coroutine(){
+		if(m_promise)
+			m_promise->ReleaseOwner();
+	}
+
+	Coroutine& operator=(Coroutine&& co){
+		std::swap(m_promise, co.m_promise);
+		return *this;
+	}
+
+
+	void Wait() const{
+		m_promise->Wait();
+	}
+
+	T GetResult() const{
+		return m_promise->GetResult();
+	}
+
+	TaskState GetState() const{
+		return m_promise->GetState();
+	}
+
+	bool IsReady() const{
+		return GetState() >= TS_READY;
+	}
+
+	Awaiter operator co_await() const &{
+		return Awaiter(m_promise, false);
+	}
+	Awaiter operator co_await() &&{
+		return Awaiter(m_promise, true);
+	}
+
+private:
+	promise_type*	m_promise;
+};
+
+
+template <>
+class Coroutine<void>{
+	friend class ThreadManager;
+public:
+	class promise_type : public PromiseBase{
+	public:
+		Coroutine get_return_object(){
+			SetHandle( std::coroutine_handle<promise_type>::from_promise(*this) );
+			return Coroutine(this);
+		}
+
+		void return_void(){}
+
+		void GetResult(){
+			Wait();
+			RethrowIfFailed();
+		}
+	};
+
+private:
+	class Awaiter : public PromiseBase::Awaiter{
+	public:
+		Awaiter(promise_type* promise) : PromiseBase::Awaiter(promise){}
+
+		void await_resume(){
+			static_cast<promise_type*>(m_promise)->GetResult();
+		}
+	};
+
+	Coroutine(const Coroutine&) = delete;
+	Coroutine& operator=(const Coroutine&) = delete;
+
+	explicit Coroutine(promise_type* promise) : m_promise(promise){}
+
+public:
+	Coroutine(Coroutine&& co) : m_promise(co.m_promise){
+		co.m_promise = nullptr;
+	}
+	~Coroutine(){
+		if(m_promise)
+			m_promise->ReleaseOwner();
+	}
+
+	Coroutine& operator=(Coroutine&& co){
+		std::swap(m_promise, co.m_promise);
+		return *this;
+	}
+
+
+	void Wait() const{
+		m_promise->Wait();
+	}
+
+	void GetResult() const{
+		m_promise->GetResult();
+	}
+
+	TaskState GetState() const{
+		return m_promise->GetState();
+	}
+
+	bool IsReady() const{
+		return GetState() >= TS_READY;
+	}
+
+	Awaiter operator co_await() const{
+		return Awaiter(m_promise);
+	}
+
+private:
+	promise_type*	m_promise;
+};
+
+
+//======================================
+//   : 
+//     
+//======================================
+class Yield{
+public:
+	bool await_ready() const{
+		return false;
+	}
+
+	template <class Promise>
+	bool await_suspend(std::coroutine_handle<Promise> handle){
+		if constexpr(std::is_base_of<PromiseBase, Promise>::value){
+			IScheduler* scheduler = handle.promise().GetScheduler();
+			if(scheduler){
+				scheduler->Schedule(handle, handle.promise().GetPriority());
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void await_resume() const{}
+};
+
+
+//======================================
+//    ; 
+//    ;  
+//    
+//======================================
+class Delay{
+public:
+	template <class Rep, class Period>
+	Delay(std::chrono::duration<Rep, Period> delay) : m_time(IScheduler::Clock::now() + std::chrono::duration_cast<IScheduler::Clock::duration>(delay)){}
+	Delay(IScheduler::Clock::time_point time) : m_time(time){}
+
+	bool await_ready() const{
+		return IScheduler::Clock::now() >= m_time;
+	}
+
+	template <class Promise>
+	bool await_suspend(std::coroutine_handle<Promise> handle){
+		if constexpr(std::is_base_of<PromiseBase, Promise>::value){
+			IScheduler* scheduler = handle.promise().GetScheduler();
+			if(scheduler){
+				scheduler->ScheduleAt(handle, m_time, handle.promise().GetPriority());
+				return true;
+			}
+		}
+		std::this_thread::sleep_until(m_time);
+		return false;
+	}
+
+	void await_resume() const{}
+
+private:
+	IScheduler::Clock::time_point	m_time;
+};
+
+}
+}
\ No newline at end of file
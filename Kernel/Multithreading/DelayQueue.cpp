@@ -0,0 +1,106 @@
+#include "DelayQueue.h"
+#include <algorithm>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+DelayQueue::DelayQueue(ReleaseFunction release) :
+	m_release(std::move(release)),
+	m_wheel(IScheduler::Clock::now()),
+	m_wakeTime(IScheduler::Clock::time_point::max()),
+	m_stop(false)
+{}
+
+DelayQueue::~DelayQueue(){
+	Stop();
+}
+
+
+TimerPtr DelayQueue::Add(const std::shared_ptr<TaskBase>& task, IScheduler::Clock::time_point time, TaskPriority priority, IScheduler::Clock::duration period){
+	TimerPtr timer = std::make_shared<Timer>();
+	timer->task		= task;
+	timer->priority	= priority;
+	timer->time		= time;
+	timer->period	= period;
+	timer->firings	= 0;
+
+	bool isEarliest;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(m_stop)
+			return timer;
+		if(!m_thread.joinable())
+			m_thread = std::thread([this](){ ThreadFunction(); });
+
+		m_wheel.Insert(timer);
+		isEarliest = time < m_wakeTime;
+	}
+
+	if(isEarliest)										//      
+		m_condition.notify_one();
+	return timer;
+}
+
+bool DelayQueue::Cancel(Timer& timer){
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_wheel.Remove(timer);						//   ,   
+}
+
+void DelayQueue::Stop(){
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_condition.notify_one();
+
+	if(m_thread.joinable())
+		m_thread.join();
+}
+
+size_t DelayQueue::GetSize() const{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_wheel.GetSize();
+}
+
+
+void DelayQueue::ThreadFunction(){
+	std::vector<TimerPtr> ready;
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while(!m_stop){
+		IScheduler::Clock::time_point now = IScheduler::Clock::now();
+		m_wheel.Advance(now, ready);
+
+		if(ready.empty()){
+			m_wakeTime = m_wheel.GetNextCheckTime();
+			if(m_wakeTime == IScheduler::Clock::time_point::max())
+				m_condition.wait(lock);
+			else
+				m_condition.wait_until(lock, m_wakeTime);
+			continue;
+		}
+
+	//        ,    
+		for(auto& timer : ready){
+			timer->firings++;
+			if(timer->period > IScheduler::Clock::duration::zero()){
+				timer->time += timer->period;
+				if(timer->time <= now)
+					timer->time = now + timer->period;
+				m_wheel.Insert(timer);
+			}
+		}
+
+		m_wakeTime = now;								//         
+		lock.unlock();
+		m_release(ready);
+		ready.clear();
+		lock.lock();
+	}
+}
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+/****************************************************************************
+*	  : ExecuteAfter/At/Every ThreadManager' 		*
+*	  (co_await Delay(...));   			*
+*	 ,       		*
+*	     release;  	*
+*	     ;   		*
+*	 														*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ITask.h"
+#include "IScheduler.h"
+#include "TimerWheel.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class KERNEL_API DelayQueue{
+public:
+	typedef std::function<void(std::vector<TimerPtr>& expired)>	ReleaseFunction;
+
+private:
+	DelayQueue(const DelayQueue&) = delete;
+	DelayQueue& operator=(const DelayQueue&) = delete;
+
+public:
+	DelayQueue(ReleaseFunction release);
+	~DelayQueue();
+
+// period - 0   ,     time, time+period, ...
+	TimerPtr	Add(const std::shared_ptr<TaskBase>& task, IScheduler::Clock::time_point time, TaskPriority priority,
+					IScheduler::Clock::duration period=IScheduler::Clock::duration::zero());
+	bool		Cancel(Timer& timer);					// false -        
+	void		Stop();									//      
+	size_t		GetSize() const;
+
+private:
+	void		ThreadFunction();
+
+private:
+	ReleaseFunction				m_release;
+	TimerWheel					m_wheel;
+	IScheduler::Clock::time_point	m_wakeTime;			//    
+	mutable std::mutex			m_mutex;
+	std::condition_variable		m_condition;
+	std::thread					m_thread;
+	bool						m_stop;
+};
+
+
+//      O(1);        
+class TimerHandle{
+public:
+	TimerHandle(const TimerPtr& timer, DelayQueue* queue) : m_timer(timer), m_queue(queue){}
+
+	bool Cancel(){
+		return m_queue->Cancel(*m_timer);
+	}
+
+private:
+	TimerPtr		m_timer;
+	DelayQueue*		m_queue;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include "EpochManager.h"
+#include "Backoff.h"
+#include "../Exception/Exception.h"
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+//======================================
+// ,   ;
+//     
+//     ;
+//      
+//  (  ),
+//    
+//======================================
+class EpochManager::RecordHolder{
+public:
+	~RecordHolder(){
+		if(s_record)
+			EpochManager::Instance().ReleaseRecord(s_record);
+		s_record = nullptr;
+	}
+
+	static thread_local ThreadRecord*	s_record;			//  :    
+};
+
+thread_local EpochManager::ThreadRecord*	EpochManager::RecordHolder::s_record = nullptr;
+
+
+EpochManager::ThreadRecord::ThreadRecord() : next(nullptr), nesting(0), retireCount(0){
+	localEpoch.store(0);
+	inUse.store(false);
+	for(uint32_t i=0; i<BUCKET_COUNT; i++)
+		limbo[i].epoch = 0;
+}
+
+
+EpochManager::EpochManager(){
+	m_epoch.store(BUCKET_COUNT);						//  epoch - 2     
+	m_records.store(nullptr);
+	m_orphanCount.store(0);
+}
+
+EpochManager::~EpochManager(){
+}
+
+
+EpochManager& EpochManager::Instance(){
+//  :           
+	static EpochManager* singleton = new EpochManager();
+	return *singleton;
+}
+
+
+void EpochManager::Enter(){
+	ThreadRecord* record = LocalRecord();
+	if(record->nesting++ == 0){
+		record->localEpoch.store( (m_epoch.load() << 1) | 1 );
+		std::atomic_thread_fence(std::memory_order_seq_cst);		//        
+	}
+}
+
+void EpochManager::Exit(){
+	ThreadRecord* record = LocalRecord();
+	RGE_Assert(record->nesting != 0, Exception::WrongState, "Thread isn't in critical section");
+	if(--record->nesting == 0)
+		record->localEpoch.store(0, std::memory_order_release);
+}
+
+bool EpochManager::IsInCriticalSection(){
+	return LocalRecord()->nesting != 0;
+}
+
+
+void EpochManager::Retire(const RetiredObject& obj){
+	ThreadRecord* record = LocalRecord();
+	uint64_t epoch = m_epoch.load();
+
+	LimboBucket& bucket = record->limbo[epoch % BUCKET_COUNT];
+	if(bucket.epoch != epoch){
+		FreeExpired(record, epoch);								//  ,    <= epoch - 3
+		bucket.epoch = epoch;
+	}
+	bucket.objects.push_back(obj);
+
+	if(++record->retireCount >= ADVANCE_THRESHOLD){
+		record->retireCount = 0;
+		if(TryAdvance())
+			FreeExpired(record, m_epoch.load());
+	}
+}
+
+
+void EpochManager::Quiesce(){
+	ThreadRecord* record = LocalRecord();
+	if(record->nesting != 0)
+		return;
+
+	bool hasLimbo = false;
+	for(uint32_t i=0; i<BUCKET_COUNT && !hasLimbo; i++)
+		hasLimbo = !record->limbo[i].objects.empty();
+	bool hasOrphans = m_orphanCount.load(std::memory_order_relaxed) != 0;
+	if(!hasLimbo && !hasOrphans)
+		return;
+
+	TryAdvance();
+	uint64_t epoch = m_epoch.load();
+	FreeExpired(record, epoch);
+	if(hasOrphans)
+		FreeOrphans(epoch);
+}
+
+void EpochManager::Synchronize(){
+	ThreadRecord* record = LocalRecord();
+	RGE_Assert(record->nesting == 0, Exception::WrongState, "Synchronize called inside critical section");
+
+	uint64_t target = m_epoch.load() + 2;
+	Backoff backoff;
+	while(m_epoch.load() < target){
+		if(!TryAdvance())
+			backoff.Pause();
+	}
+
+	uint64_t epoch = m_epoch.load();
+	FreeExpired(record, epoch);
+	FreeOrphans(epoch);
+}
+
+
+uint64_t EpochManager::GetEpoch() const{
+	return m_epoch.load(std::memory_order_relaxed);
+}
+
+
+EpochManager::ThreadRecord* EpochManager::LocalRecord(){
+	static thread_local RecordHolder	holder;				//     
+
+	if(RecordHolder::s_record == nullptr)
+		RecordHolder::s_record = AcquireRecord();
+	return RecordHolder::s_record;
+}
+
+EpochManager::ThreadRecord* EpochManager::AcquireRecord(){
+	for(ThreadRecord* record = m_records.load(); record != nullptr; record = record->next){
+		bool expected = false;
+		if(!record->inUse.load(std::memory_order_relaxed) && record->inUse.compare_exchange_strong(expected, true))
+			return record;
+	}
+
+	ThreadRecord* record = new ThreadRecord();
+	record->inUse.store(true);
+
+	ThreadRecord* head = m_records.load();
+	do{
+		record->next = head;
+	} while(!m_records.compare_exchange_weak(head, record));
+
+	return record;
+}
+
+void EpochManager::ReleaseRecord(ThreadRecord* record){
+	{
+		std::lock_guard<std::mutex> lock(m_orphansMutex);
+		for(uint32_t i=0; i<BUCKET_COUNT; i++){
+			if(!record->limbo[i].objects.empty()){
+				m_orphans.push_back( std::move(record->limbo[i]) );
+				record->limbo[i].objects.clear();
+				m_orphanCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	record->nesting = 0;
+	record->retireCount = 0;
+	record->localEpoch.store(0);
+	record->inUse.store(false);
+}
+
+
+//   ,          
+bool EpochManager::TryAdvance(){
+	uint64_t epoch = m_epoch.load();
+	for(ThreadRecord* record = m_records.load(); record != nullptr; record = record->next){
+		uint64_t local = record->localEpoch.load();
+		if((local & 1) && (local >> 1) != epoch)
+			return false;
+	}
+
+	return m_epoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+//      ,    
+void EpochManager::FreeExpired(ThreadRecord* record, uint64_t epoch){
+	for(uint32_t i=0; i<BUCKET_COUNT; i++){
+		LimboBucket& bucket = record->limbo[i];
+		if(bucket.objects.empty() || bucket.epoch + 2 > epoch)
+			continue;
+
+		std::vector<RetiredObject> objects;
+		objects.swap(bucket.objects);
+		for(auto& obj : objects)
+			obj.Free();
+	}
+}
+
+void EpochManager::FreeOrphans(uint64_t epoch){
+	std::vector<LimboBucket> expired;
+	{
+		std::unique_lock<std::mutex> lock(m_orphansMutex, std::try_to_lock);
+		if(!lock.owns_lock())
+			return;
+
+		for(size_t i=0; i<m_orphans.size(); ){
+			if(m_orphans[i].epoch + 2 <= epoch){
+				expired.push_back( std::move(m_orphans[i]) );
+				m_orphans[i] = std::move(m_orphans.back());
+				m_orphans.pop_back();
+				m_orphanCount.fetch_sub(1, std::memory_order_relaxed);
+			}
+			else
+				i++;
+		}
+	}
+
+	for(auto& bucket : expired)
+		for(auto& obj : bucket.objects)
+			obj.Free();
+}
+
+}
+}
\ No newline at end of file
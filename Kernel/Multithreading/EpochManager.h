@@ -0,0 +1,116 @@
+/****************************************************************************
+*	     (EBR):								*
+*	,     , 			*
+*	   (EpochGuard)     		*
+*	,   ;	  ,  			*
+*	   ; ,    E,			*
+*	  ,     E+2;				*
+*	  ThreadManager  Quiesce  ;			*
+*	NOTE:  ,    							*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Reclamation.h"
+#include "../Platform/Settings.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class KERNEL_API EpochManager{
+private:
+	static const uint32_t	BUCKET_COUNT		= 3;
+	static const uint32_t	ADVANCE_THRESHOLD	= 64;		//       
+
+	struct LimboBucket{
+		std::vector<RetiredObject>	objects;
+		uint64_t					epoch;					// ,     
+	};
+
+	struct ThreadRecord{
+		ThreadRecord();
+
+		std::atomic<uint64_t>	localEpoch;					// ( << 1) | 1,     ,  0
+		std::atomic_bool		inUse;
+		ThreadRecord*			next;
+		uint32_t				nesting;
+		uint32_t				retireCount;
+		LimboBucket				limbo[BUCKET_COUNT];
+		uint8_t					pad[RGE_CACHE_LINE_SIZE];
+	};
+
+	class RecordHolder;
+
+private:
+	EpochManager();
+	~EpochManager();
+	EpochManager(const EpochManager&) = delete;
+	EpochManager& operator=(const EpochManager&) = delete;
+
+public:
+
+	static EpochManager& Instance();
+
+	void		Enter();
+	void		Exit();
+	bool		IsInCriticalSection();
+
+	void		Retire(const RetiredObject& obj);
+	template <class T>
+	void		Retire(T* ptr){
+		Retire(MakeRetired(ptr));
+	}
+	template <class T>
+	void		Retire(T* ptr, Memory::IAllocator& allocator){
+		Retire(MakeRetired(ptr, allocator));
+	}
+
+	void		Quiesce();									//    :      
+	void		Synchronize();								// ,    ,    
+
+	uint64_t	GetEpoch() const;
+
+private:
+	ThreadRecord*	LocalRecord();
+	ThreadRecord*	AcquireRecord();
+	void			ReleaseRecord(ThreadRecord* record);	//    
+
+	bool			TryAdvance();
+	void			FreeExpired(ThreadRecord* record, uint64_t epoch);
+	void			FreeOrphans(uint64_t epoch);
+
+private:
+	std::atomic<uint64_t>		m_epoch;
+	uint8_t						m_pad[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)];
+	std::atomic<ThreadRecord*>	m_records;
+
+	std::mutex					m_orphansMutex;				// ,    
+	std::vector<LimboBucket>	m_orphans;
+	std::atomic<uint32_t>		m_orphanCount;
+};
+
+
+//   
+class EpochGuard{
+private:
+	EpochGuard(const EpochGuard&) = delete;
+	EpochGuard& operator=(const EpochGuard&) = delete;
+
+public:
+	EpochGuard(){
+		EpochManager::Instance().Enter();
+	}
+	~EpochGuard(){
+		EpochManager::Instance().Exit();
+	}
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+/****************************************************************************
+*	        			*
+*	;     ,    ;	*
+*	:	key = PrepareWait(); if() CancelWait();				*
+*				else Wait(key);												*
+*	:  ,   NotifyOne/NotifyAll		*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "AtomicWait.h"
+#include <atomic>
+#include <cstdint>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class EventCount{
+private:
+	EventCount(const EventCount&) = delete;
+	EventCount& operator=(const EventCount&) = delete;
+
+public:
+	EventCount(){
+		m_epoch.store(0);
+		m_waiters.store(0);
+	}
+
+	uint32_t PrepareWait(){
+		m_waiters.fetch_add(1);
+		return m_epoch.load();
+	}
+
+	void CancelWait(){
+		m_waiters.fetch_sub(1);
+	}
+
+	void Wait(uint32_t key){
+		m_spin.Wait(m_epoch, key);
+		m_waiters.fetch_sub(1);
+	}
+
+// ,  ready()   true
+	template <class Predicate>
+	void Await(Predicate ready){
+		while(!ready()){
+			uint32_t key = PrepareWait();
+			if(ready()){
+				CancelWait();
+				return;
+			}
+			Wait(key);
+		}
+	}
+
+	void NotifyOne(){
+		m_epoch.fetch_add(1);
+		if(m_waiters.load() != 0)
+			m_epoch.notify_one();
+	}
+
+	void NotifyAll(){
+		m_epoch.fetch_add(1);
+		if(m_waiters.load() != 0)
+			m_epoch.notify_all();
+	}
+
+private:
+	std::atomic<uint32_t>	m_epoch;
+	std::atomic<uint32_t>	m_waiters;
+	AdaptiveSpin			m_spin;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "Fiber.h"
+#include "../Exception/Exception.h"
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+Fiber::Fiber() :
+	m_context(nullptr),
+	m_stack(nullptr),
+	m_stackSize(0),
+	m_function(nullptr),
+	m_arg(nullptr),
+	m_isThread(true)
+{
+	CreateThreadContext();
+}
+
+Fiber::Fiber(Function function, void* arg, size_t stackSize) :
+	m_context(nullptr),
+	m_stack(nullptr),
+	m_stackSize(stackSize),
+	m_function(function),
+	m_arg(arg),
+	m_isThread(false)
+{
+	RGE_Assert(function != nullptr, Exception::WrongArgument, "Fiber function is null");
+	CreateContext();
+}
+
+Fiber::~Fiber(){
+	DestroyContext();
+}
+
+
+void Fiber::SwitchTo(Fiber& next){
+	RGE_Assert(&next != this, Exception::WrongArgument, "Fiber can't switch to itself");
+	SwitchContext(next);
+}
+
+size_t Fiber::GetStackSize() const{
+	return m_stackSize;
+}
+
+
+#if !defined(RGE_WINDOWS) && !defined(RGE_LINUX)
+void Fiber::CreateThreadContext(){
+	RGE_Throw(Exception::NotImplemented, "Fibers aren't supported on this platform");
+}
+
+void Fiber::CreateContext(){
+	RGE_Throw(Exception::NotImplemented, "Fibers aren't supported on this platform");
+}
+
+void Fiber::DestroyContext(){}
+
+void Fiber::SwitchContext(Fiber&){}
+#endif
+
+}
+}
\ No newline at end of file
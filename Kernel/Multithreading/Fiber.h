@@ -0,0 +1,58 @@
+/****************************************************************************
+*	 -     , 			*
+*	   (Linux x86-64 -  ,	*
+*	 Linux - ucontext, Windows - Fiber API);							*
+*	      ,		*
+*	   ;    				*
+*	 -       ;			*
+*	     								*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "../Platform/Settings.h"
+#include <cstddef>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class KERNEL_API Fiber{
+public:
+	typedef void (*Function)(void* arg);
+
+	static const size_t		DEFAULT_STACK_SIZE = 256 * 1024;
+
+private:
+	Fiber(const Fiber&) = delete;
+	Fiber& operator=(const Fiber&) = delete;
+
+public:
+	Fiber();												//   
+	Fiber(Function function, void* arg, size_t stackSize = DEFAULT_STACK_SIZE);
+	~Fiber();
+
+	void				SwitchTo(Fiber& next);				//     this   next
+
+	size_t				GetStackSize() const;
+
+private:
+//   Platform/<>/Fiber_<>Impl.cpp
+	void				CreateThreadContext();
+	void				CreateContext();
+	void				DestroyContext();
+	void				SwitchContext(Fiber& next);
+
+private:
+	void*				m_context;
+	void*				m_stack;							// nullptr        
+	size_t				m_stackSize;
+	Function			m_function;
+	void*				m_arg;
+	bool				m_isThread;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "FiberScheduler.h"
+#include "WorkerContext.h"
+#include "../Exception/Exception.h"
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+static thread_local FiberScheduler*	s_current = nullptr;
+
+
+FiberScheduler::FiberScheduler(EventCount& event, size_t stackSize) :
+	m_event(event),
+	m_running(nullptr),
+	m_suspendedCount(0),
+	m_stackSize(stackSize)
+{
+	RGE_Assert(s_current == nullptr, Exception::WrongState, "Thread already has fiber scheduler");
+	s_current = this;
+}
+
+//      ,     
+FiberScheduler::~FiberScheduler(){
+	s_current = nullptr;
+}
+
+
+FiberScheduler* FiberScheduler::Current(){
+	return s_current;
+}
+
+
+void FiberScheduler::Run(const ITaskPtr& task){
+	JobFiber* job;
+	if(m_free.empty()){
+		m_fibers.push_back( std::unique_ptr<JobFiber>(new JobFiber(this, m_stackSize)) );
+		job = m_fibers.back().get();
+	}
+	else{
+		job = m_free.back();
+		m_free.pop_back();
+	}
+
+	job->task = task;
+	Resume(job);
+}
+
+//     :         
+bool FiberScheduler::RunReady(){
+	size_t count = m_ready.size();
+	JobFiber* job;
+	for(size_t i=0; i<count && m_ready.try_pop(&job); i++){
+		m_suspendedCount--;
+		Resume(job);
+	}
+	return count != 0;
+}
+
+
+bool FiberScheduler::IsInFiber() const{
+	return m_running != nullptr;
+}
+
+bool FiberScheduler::HasReady() const{
+	return !m_ready.empty();
+}
+
+size_t FiberScheduler::GetSuspendedCount() const{
+	return m_suspendedCount;
+}
+
+size_t FiberScheduler::GetFiberCount() const{
+	return m_fibers.size();
+}
+
+//      ,      ,
+//        
+uint32_t FiberScheduler::GetScratchMark() const{
+	uint32_t mark = 0;
+	if(m_suspendedCount == 0)
+		return mark;
+	for(const auto& job : m_fibers)
+		if((job->state == FS_SUSPENDED || job->state == FS_YIELDED) && job->scratchMark > mark)
+			mark = job->scratchMark;
+	return mark;
+}
+
+
+void FiberScheduler::Reschedule(){
+	RGE_Assert(IsInFiber(), Exception::WrongState, "Reschedule outside of fiber");
+	Suspend(FS_YIELDED);
+}
+
+
+void FiberScheduler::FiberFunction(void* arg){
+	JobFiber* job = static_cast<JobFiber*>(arg);
+	for(;;){
+		job->task->Perform();
+		job->task.reset();
+		job->owner->Suspend(FS_FINISHED);				//          
+	}
+}
+
+void FiberScheduler::Resume(JobFiber* job){
+	job->state	= FS_RUNNING;
+	m_running	= job;
+	m_threadFiber.SwitchTo(job->fiber);
+	m_running	= nullptr;
+
+	switch(job->state){
+	case FS_FINISHED:	m_free.push_back(job);	break;
+	case FS_SUSPENDED:
+	case FS_YIELDED:	m_suspendedCount++;		break;
+	default:									break;
+	}
+}
+
+//         ,
+//        -     Resume
+void FiberScheduler::Suspend(FiberState state){
+	JobFiber* job = m_running;
+	job->state = state;
+	if(state != FS_FINISHED){
+		WorkerContext* context = WorkerContext::Current();
+		job->scratchMark = context != nullptr ? context->GetScratch().GetUsedMemorySize_unsafe() : 0;
+	}
+	if(state == FS_YIELDED)
+		m_ready.push(job);
+	job->fiber.SwitchTo(m_threadFiber);
+}
+
+void FiberScheduler::MakeReady(JobFiber* job){
+	m_ready.push(job);
+	m_event.NotifyAll();
+}
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+/****************************************************************************
+*	     : , 			*
+*	  (TaskBase::Wait)   (CompletionCounter::Wait),	*
+*	   ,    ;  			*
+*	  fork-join,    		*
+*	    ;      			*
+*	     									*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ITask.h"
+#include "Fiber.h"
+#include "Continuation.h"
+#include "EventCount.h"
+#include "SegmentedQueue.h"
+#include <memory>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class KERNEL_API FiberScheduler{
+private:
+	enum FiberState{
+		FS_RUNNING = 0,
+		FS_FINISHED,			//  ,     
+		FS_SUSPENDED,			//     
+		FS_YIELDED				//     
+	};
+
+	struct JobFiber{
+		JobFiber(FiberScheduler* scheduler, size_t stackSize) : fiber(&FiberFunction, this, stackSize), owner(scheduler), state(FS_FINISHED), scratchMark(0){}
+
+		Fiber				fiber;
+		ITaskPtr			task;
+		FiberScheduler*		owner;
+		FiberState			state;
+		uint32_t			scratchMark;		//       
+	};
+
+	struct FiberContinuation : public Continuation{
+		FiberContinuation(JobFiber* job) : Continuation(&OnReady), fiber(job){}
+
+		static void OnReady(Continuation* cont){
+			JobFiber* job = static_cast<FiberContinuation*>(cont)->fiber;
+			job->owner->MakeReady(job);
+		}
+
+		JobFiber*			fiber;
+	};
+
+	FiberScheduler(const FiberScheduler&) = delete;
+	FiberScheduler& operator=(const FiberScheduler&) = delete;
+
+public:
+//   ,      ; event   
+	FiberScheduler(EventCount& event, size_t stackSize = Fiber::DEFAULT_STACK_SIZE);
+	~FiberScheduler();
+
+	static FiberScheduler*	Current();							//   ; nullptr,   
+
+	void					Run(const ITaskPtr& task);			// ,     
+	bool					RunReady();							//  ,  ; false,   
+
+	bool					IsInFiber() const;					//       
+	bool					HasReady() const;
+	size_t					GetSuspendedCount() const;			//     (  )
+	size_t					GetFiberCount() const;				//    ( )
+	uint32_t				GetScratchMark() const;				//       ; 0 -  
+
+//   : add   (false -   ),
+//    ,     
+	template <typename F>
+	void Await(F&& add){
+		FiberContinuation cont(m_running);
+		if(!add(static_cast<Continuation*>(&cont)))
+			return;
+		Suspend(FS_SUSPENDED);
+	}
+
+	void					Reschedule();						//       ( )
+
+private:
+	static void				FiberFunction(void* arg);
+
+	void					Resume(JobFiber* job);
+	void					Suspend(FiberState state);
+	void					MakeReady(JobFiber* job);			//     
+
+private:
+	Fiber								m_threadFiber;
+	std::vector<std::unique_ptr<JobFiber>>	m_fibers;
+	std::vector<JobFiber*>				m_free;
+	SegmentedQueue<JobFiber*>			m_ready;
+	EventCount&							m_event;
+	JobFiber*							m_running;
+	size_t								m_suspendedCount;
+	size_t								m_stackSize;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "HazardPointer.h"
+#include <algorithm>
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+//======================================
+//    ;
+//    ,  
+// ,    
+//======================================
+class HazardPointerDomain::RetiredHolder{
+public:
+	~RetiredHolder(){
+		std::vector<RetiredObject>* objects = s_objects;
+		s_objects = nullptr;
+		if(objects == nullptr)
+			return;
+
+		HazardPointerDomain& domain = HazardPointerDomain::Instance();
+		domain.Scan(*objects);
+
+		std::lock_guard<std::mutex> lock(domain.m_orphansMutex);
+		domain.m_orphans.insert(domain.m_orphans.end(), objects->begin(), objects->end());
+		domain.m_orphanCount.store(static_cast<uint32_t>(domain.m_orphans.size()), std::memory_order_relaxed);
+		delete objects;
+	}
+
+	static thread_local std::vector<RetiredObject>*	s_objects;		//  :    
+};
+
+thread_local std::vector<RetiredObject>*	HazardPointerDomain::RetiredHolder::s_objects = nullptr;
+
+
+HazardPointerDomain::Record::Record() : next(nullptr){
+	hazard.store(nullptr);
+	active.store(false);
+}
+
+
+HazardPointerDomain::HazardPointerDomain(){
+	m_records.store(nullptr);
+	m_recordCount.store(0);
+	m_orphanCount.store(0);
+}
+
+HazardPointerDomain::~HazardPointerDomain(){
+}
+
+
+HazardPointerDomain& HazardPointerDomain::Instance(){
+//  :           
+	static HazardPointerDomain* singleton = new HazardPointerDomain();
+	return *singleton;
+}
+
+
+void HazardPointerDomain::Retire(const RetiredObject& obj){
+	std::vector<RetiredObject>& retired = LocalRetired();
+	retired.push_back(obj);
+
+	uint32_t threshold = 2 * m_recordCount.load(std::memory_order_relaxed);
+	if(threshold < SCAN_THRESHOLD)
+		threshold = SCAN_THRESHOLD;
+
+	if(retired.size() >= threshold)
+		Scan();
+}
+
+void HazardPointerDomain::Scan(){
+	Scan(LocalRetired());
+
+	if(m_orphanCount.load(std::memory_order_relaxed) == 0)
+		return;
+
+	std::vector<RetiredObject> orphans;
+	{
+		std::unique_lock<std::mutex> lock(m_orphansMutex, std::try_to_lock);
+		if(!lock.owns_lock())
+			return;
+		orphans.swap(m_orphans);
+		m_orphanCount.store(0, std::memory_order_relaxed);
+	}
+
+	Scan(orphans);
+	if(!orphans.empty()){
+		std::lock_guard<std::mutex> lock(m_orphansMutex);
+		m_orphans.insert(m_orphans.end(), orphans.begin(), orphans.end());
+		m_orphanCount.store(static_cast<uint32_t>(m_orphans.size()), std::memory_order_relaxed);
+	}
+}
+
+bool HazardPointerDomain::IsProtected(const void* ptr) const{
+	for(Record* record = m_records.load(); record != nullptr; record = record->next)
+		if(record->hazard.load() == ptr)
+			return true;
+	return false;
+}
+
+
+HazardPointerDomain::Record* HazardPointerDomain::AcquireRecord(){
+	for(Record* record = m_records.load(); record != nullptr; record = record->next){
+		bool expected = false;
+		if(!record->active.load(std::memory_order_relaxed) && record->active.compare_exchange_strong(expected, true))
+			return record;
+	}
+
+	Record* record = new Record();
+	record->active.store(true);
+
+	Record* head = m_records.load();
+	do{
+		record->next = head;
+	} while(!m_records.compare_exchange_weak(head, record));
+	m_recordCount.fetch_add(1, std::memory_order_relaxed);
+
+	return record;
+}
+
+void HazardPointerDomain::ReleaseRecord(Record* record){
+	record->hazard.store(nullptr, std::memory_order_release);
+	record->active.store(false, std::memory_order_release);
+}
+
+
+std::vector<RetiredObject>& HazardPointerDomain::LocalRetired(){
+	static thread_local RetiredHolder	holder;				//         
+
+	if(RetiredHolder::s_objects == nullptr)
+		RetiredHolder::s_objects = new std::vector<RetiredObject>();
+	return *RetiredHolder::s_objects;
+}
+
+//      ,    
+void HazardPointerDomain::Scan(std::vector<RetiredObject>& retired){
+	if(retired.empty())
+		return;
+
+	std::vector<const void*> hazards;
+	CollectHazards(hazards);
+
+	std::vector<RetiredObject> candidates;
+	candidates.swap(retired);
+	for(auto& obj : candidates){
+		if(std::binary_search(hazards.begin(), hazards.end(), static_cast<const void*>(obj.ptr)))
+			retired.push_back(obj);
+		else
+			obj.Free();
+	}
+}
+
+void HazardPointerDomain::CollectHazards(std::vector<const void*>& hazards) const{
+	std::atomic_thread_fence(std::memory_order_seq_cst);			//       
+	for(Record* record = m_records.load(); record != nullptr; record = record->next){
+		const void* ptr = record->hazard.load();
+		if(ptr != nullptr)
+			hazards.push_back(ptr);
+	}
+	std::sort(hazards.begin(), hazards.end());
+}
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+/****************************************************************************
+*	  (hazard pointers):    ,	*
+*	  ,     ,  			*
+*	;       				*
+*	     ;				*
+*	   ,    				*
+*	      ;							*
+*	HazardPointer    							*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Reclamation.h"
+#include "../Platform/Settings.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class KERNEL_API HazardPointerDomain{
+	friend class HazardPointer;
+private:
+	static const uint32_t	SCAN_THRESHOLD = 64;		//       
+
+	struct Record{
+		Record();
+
+		std::atomic<const void*>	hazard;
+		std::atomic_bool			active;
+		Record*						next;
+		uint8_t						pad[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<const void*>) - sizeof(std::atomic_bool) - sizeof(Record*)];
+	};
+
+	class RetiredHolder;
+
+private:
+	HazardPointerDomain();
+	~HazardPointerDomain();
+	HazardPointerDomain(const HazardPointerDomain&) = delete;
+	HazardPointerDomain& operator=(const HazardPointerDomain&) = delete;
+
+public:
+
+	static HazardPointerDomain& Instance();
+
+	void		Retire(const RetiredObject& obj);
+	template <class T>
+	void		Retire(T* ptr){
+		Retire(MakeRetired(ptr));
+	}
+	template <class T>
+	void		Retire(T* ptr, Memory::IAllocator& allocator){
+		Retire(MakeRetired(ptr, allocator));
+	}
+
+	void		Scan();										//   ,   
+	bool		IsProtected(const void* ptr) const;
+
+private:
+	Record*		AcquireRecord();
+	void		ReleaseRecord(Record* record);
+
+	std::vector<RetiredObject>&	LocalRetired();
+	void		Scan(std::vector<RetiredObject>& retired);
+	void		CollectHazards(std::vector<const void*>& hazards) const;
+
+private:
+	std::atomic<Record*>		m_records;
+	std::atomic<uint32_t>		m_recordCount;
+
+	std::mutex					m_orphansMutex;				// ,    
+	std::vector<RetiredObject>	m_orphans;
+	std::atomic<uint32_t>		m_orphanCount;
+};
+
+
+class HazardPointer{
+private:
+	HazardPointer(const HazardPointer&) = delete;
+	HazardPointer& operator=(const HazardPointer&) = delete;
+
+public:
+	HazardPointer() : m_record(HazardPointerDomain::Instance().AcquireRecord()){}
+	HazardPointer(std::nullptr_t) : m_record(nullptr){}		//     Set   
+	HazardPointer(HazardPointer&& hp) : m_record(hp.m_record){
+		hp.m_record = nullptr;
+	}
+	~HazardPointer(){
+		if(m_record){
+			Reset();
+			HazardPointerDomain::Instance().ReleaseRecord(m_record);
+		}
+	}
+
+	HazardPointer& operator=(HazardPointer&& hp){
+		std::swap(m_record, hp.m_record);
+		return *this;
+	}
+
+//   src; ,  src   
+	template <class T>
+	T* Protect(const std::atomic<T*>& src){
+		T* ptr = src.load(std::memory_order_relaxed);
+		while(true){
+			m_record->hazard.store(ptr);
+			T* check = src.load(std::memory_order_acquire);
+			if(check == ptr)
+				return ptr;
+			ptr = check;
+		}
+	}
+
+//  ,     (,  EpochGuard)
+	void Set(const void* ptr){
+		if(m_record == nullptr){
+			if(ptr == nullptr)
+				return;
+			m_record = HazardPointerDomain::Instance().AcquireRecord();
+		}
+		m_record->hazard.store(ptr);
+	}
+
+	void Reset(){
+		if(m_record)
+			m_record->hazard.store(nullptr, std::memory_order_release);
+	}
+
+	const void* Get() const{
+		return m_record ? m_record->hazard.load(std::memory_order_relaxed) : nullptr;
+	}
+
+private:
+	HazardPointerDomain::Record*	m_record;
+};
+
+}
+}
\ No newline at end of file
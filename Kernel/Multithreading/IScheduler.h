@@ -0,0 +1,30 @@
+/****************************************************************************
+*	 ,    ;				*
+*	 ThreadManager':     		*
+*	,    ,    				*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ITask.h"
+#include <chrono>
+#include <coroutine>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class IScheduler{
+public:
+	typedef std::chrono::steady_clock		Clock;
+
+	virtual ~IScheduler(){}
+
+	virtual void	Schedule(std::coroutine_handle<> handle, TaskPriority priority) = 0;
+	virtual void	ScheduleAt(std::coroutine_handle<> handle, Clock::time_point time, TaskPriority priority) = 0;
+};
+
+}
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Multithreading.h"
+#include <cstdint>
 #include <memory>
 
 
@@ -37,6 +38,8 @@ public:
 	virtual void			SetState(TaskState state) = 0;
 	virtual TaskPriority	GetPriority() const = 0;
 	virtual void			SetPriority(TaskPriority priority) = 0;
+	virtual uint32_t		GetGeneration() const = 0;		//      
+	virtual bool			IsDue() const = 0;				// false -      
 };
 
 typedef std::shared_ptr<ITask> ITaskPtr;
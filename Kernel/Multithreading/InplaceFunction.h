@@ -0,0 +1,169 @@
+/****************************************************************************
+*	 std::function,     , 		*
+*	    Capacity (    );		*
+*			 ,  						*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+template <class Signature, size_t Capacity = 6*sizeof(void*)>
+class InplaceFunction;
+
+
+template <class R, class... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>{
+private:
+	enum Operation{
+		OP_MOVE,
+		OP_DESTROY
+	};
+
+	typedef R		(*InvokeFunction)(void* storage, Args&&... args);
+	typedef void	(*ManageFunction)(void* dst, void* src, Operation op);
+	typedef typename std::aligned_storage<Capacity, alignof(std::max_align_t)>::type	Storage;
+
+	template <class F>
+	struct FitsInplace : std::integral_constant<bool,	sizeof(F) <= Capacity &&
+														alignof(std::max_align_t) % alignof(F) == 0 &&
+														std::is_nothrow_move_constructible<F>::value>{};
+
+	template <class F, bool Inplace = FitsInplace<F>::value>
+	struct Manager{
+		static F* Get(void* storage){
+			return static_cast<F*>(storage);
+		}
+
+		template <class G>
+		static void Create(void* storage, G&& f){
+			new(storage) F(std::forward<G>(f));
+		}
+
+		static R Invoke(void* storage, Args&&... args){
+			return (*Get(storage))(std::forward<Args>(args)...);
+		}
+
+		static void Manage(void* dst, void* src, Operation op){
+			if(op == OP_MOVE){
+				new(dst) F(std::move(*Get(src)));
+				Get(src)->~F();
+			}
+			else
+				Get(dst)->~F();
+		}
+	};
+
+//     :       
+	template <class F>
+	struct Manager<F, false>{
+		static F*& Get(void* storage){
+			return *static_cast<F**>(storage);
+		}
+
+		template <class G>
+		static void Create(void* storage, G&& f){
+			Get(storage) = new F(std::forward<G>(f));
+		}
+
+		static R Invoke(void* storage, Args&&... args){
+			return (*Get(storage))(std::forward<Args>(args)...);
+		}
+
+		static void Manage(void* dst, void* src, Operation op){
+			if(op == OP_MOVE){
+				Get(dst) = Get(src);
+				Get(src) = nullptr;
+			}
+			else
+				delete Get(dst);
+		}
+	};
+
+public:
+	InplaceFunction() : m_invoke(nullptr), m_manage(nullptr){}
+	InplaceFunction(std::nullptr_t) : m_invoke(nullptr), m_manage(nullptr){}
+
+	template <class F, class = typename std::enable_if< !std::is_same<typename std::decay<F>::type, InplaceFunction>::value >::type>
+	InplaceFunction(F&& f){
+		typedef typename std::decay<F>::type Functor;
+
+		Manager<Functor>::Create(&m_storage, std::forward<F>(f));
+		m_invoke = &Manager<Functor>::Invoke;
+		m_manage = &Manager<Functor>::Manage;
+	}
+
+	InplaceFunction(InplaceFunction&& func) : m_invoke(nullptr), m_manage(nullptr){
+		MoveFrom(func);
+	}
+
+	InplaceFunction(const InplaceFunction&) = delete;
+	InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+	~InplaceFunction(){
+		Reset();
+	}
+
+
+	InplaceFunction& operator=(InplaceFunction&& func){
+		if(this != &func){
+			Reset();
+			MoveFrom(func);
+		}
+		return *this;
+	}
+
+	InplaceFunction& operator=(std::nullptr_t){
+		Reset();
+		return *this;
+	}
+
+	R operator()(Args... args) const{
+		return m_invoke(&m_storage, std::forward<Args>(args)...);
+	}
+
+	explicit operator bool() const{
+		return m_invoke != nullptr;
+	}
+
+//     F   
+	template <class F>
+	static bool IsStoredInplace(){
+		return FitsInplace<typename std::decay<F>::type>::value;
+	}
+
+private:
+	void Reset(){
+		if(m_manage)
+			m_manage(&m_storage, nullptr, OP_DESTROY);
+		m_invoke = nullptr;
+		m_manage = nullptr;
+	}
+
+	void MoveFrom(InplaceFunction& func){
+		if(func.m_manage){
+			func.m_manage(&m_storage, &func.m_storage, OP_MOVE);
+			m_invoke = func.m_invoke;
+			m_manage = func.m_manage;
+			func.m_invoke = nullptr;
+			func.m_manage = nullptr;
+		}
+	}
+
+private:
+	mutable Storage		m_storage;
+	InvokeFunction		m_invoke;
+	ManageFunction		m_manage;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "JobGraph.h"
+#include "../Exception/Exception.h"
+#include <mutex>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+JobGraph::JobGraph() : m_compiled(false){
+	m_failed.store(false);
+}
+
+// m_done.Done() -     ,  Wait ,  Done  
+JobGraph::~JobGraph(){
+	m_done.Wait();
+}
+
+
+JobGraph::NodeID JobGraph::AddNode(NodeFunction function, size_t width, TaskPriority priority){
+	RGE_Assert(function != nullptr, Exception::WrongArgument, "Job graph node function is null");
+	RGE_Assert(width > 0, Exception::WrongArgument, "Job graph node width must be positive");
+	RGE_Assert(m_done.IsCompleted(), Exception::WrongState, "Job graph is running");
+
+	m_nodes.push_back(Node{ std::move(function), width, priority, {}, 0, 0 });
+	m_compiled = false;
+	return m_nodes.size() - 1;
+}
+
+void JobGraph::AddEdge(NodeID from, NodeID to){
+	RGE_Assert(from < m_nodes.size() && to < m_nodes.size(), Exception::WrongArgument, "Job graph node doesn't exist");
+	RGE_Assert(m_done.IsCompleted(), Exception::WrongState, "Job graph is running");
+
+	m_nodes[from].successors.push_back(to);
+	m_nodes[to].dependencies++;
+	m_compiled = false;
+}
+
+
+//  :       ,   
+void JobGraph::Compile(){
+	RGE_Assert(m_done.IsCompleted(), Exception::WrongState, "Job graph is running");
+
+	std::vector<uint32_t> waiting(m_nodes.size());
+	m_order.clear();
+	m_roots.clear();
+	for(NodeID node=0; node<m_nodes.size(); node++){
+		waiting[node] = m_nodes[node].dependencies;
+		if(waiting[node] == 0){
+			m_order.push_back(node);
+			m_roots.push_back(node);
+		}
+	}
+
+	for(size_t i=0; i<m_order.size(); i++)
+		for(NodeID next : m_nodes[m_order[i]].successors)
+			if(--waiting[next] == 0)
+				m_order.push_back(next);
+
+	if(m_order.size() != m_nodes.size()){
+		m_order.clear();
+		m_roots.clear();
+		RGE_Throw(Exception::WrongState, "Job graph has a cycle");
+	}
+
+//   : Kick      RerunTasks
+	m_tasks.clear();
+	for(NodeID node : m_order){
+		m_nodes[node].firstTask = m_tasks.size();
+		for(size_t part=0; part<m_nodes[node].width; part++){
+			auto task = MakeTask<void>( [this, node, part](){ RunPart(node, part); } );
+			task->SetPriority(m_nodes[node].priority);
+			task->SetState(TS_READY);
+			m_tasks.emplace_back(task);
+		}
+	}
+
+	m_waiting.reset( new std::atomic<uint32_t>[m_nodes.size()] );
+	m_pending.reset( new std::atomic<size_t>[m_nodes.size()] );
+	m_compiled = true;
+}
+
+//        TS_READY,     
+void JobGraph::Kick(){
+	RGE_Assert(m_compiled, Exception::WrongState, "Job graph isn't compiled");
+	RGE_Assert(m_done.IsCompleted(), Exception::WrongState, "Job graph is still running");
+
+	for(auto& task : m_tasks)
+		task.Wait();
+
+	m_failed.store(false);
+	m_exception = nullptr;
+	for(NodeID node=0; node<m_nodes.size(); node++){
+		m_waiting[node].store(m_nodes[node].dependencies, std::memory_order_relaxed);
+		m_pending[node].store(m_nodes[node].width, std::memory_order_relaxed);
+	}
+
+	m_done.Add(static_cast<uint32_t>(m_tasks.size()));
+	for(NodeID root : m_roots)
+		Release(root);
+}
+
+void JobGraph::Wait() const{
+	ThreadManager::Instance().HelpWait(m_done);
+	if(m_exception)
+		std::rethrow_exception(m_exception);
+}
+
+
+bool JobGraph::IsCompiled() const{
+	return m_compiled;
+}
+
+bool JobGraph::IsCompleted() const{
+	return m_done.IsCompleted();
+}
+
+size_t JobGraph::GetNodeCount() const{
+	return m_nodes.size();
+}
+
+size_t JobGraph::GetTaskCount() const{
+	return m_tasks.size();
+}
+
+const std::vector<JobGraph::NodeID>& JobGraph::GetOrder() const{
+	return m_order;
+}
+
+
+//     ; m_done  ,  Wait   
+void JobGraph::RunPart(NodeID node, size_t part){
+	Node& current = m_nodes[node];
+	if(!m_failed.load()){
+		try{
+			current.function(part, current.width);
+		}
+		catch(...){
+			std::lock_guard<Spinlock> guard(m_lock);
+			if(!m_failed.exchange(true))
+				m_exception = std::current_exception();
+		}
+	}
+
+	if(m_pending[node].fetch_sub(1, std::memory_order_acq_rel) == 1)
+		for(NodeID next : current.successors)
+			if(m_waiting[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Release(next);
+
+	m_done.Done();
+}
+
+void JobGraph::Release(NodeID node){
+	ThreadManager::Instance().RerunTasks(&m_tasks[m_nodes[node].firstTask], m_nodes[node].width);
+}
+
+}
+}
\ No newline at end of file
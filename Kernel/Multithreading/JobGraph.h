@@ -0,0 +1,85 @@
+/****************************************************************************
+*	  :  (   parallel-for) 		*
+*	   , Compile  ,  		*
+*	        ; Kick			*
+*	       		*
+*	    -     ;			*
+*	   ,     				*
+*	;      		*
+*	 ,  Wait   							*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ThreadManager.h"
+#include "CompletionCounter.h"
+#include "Spinlock.h"
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class KERNEL_API JobGraph{
+public:
+	typedef size_t											NodeID;
+	typedef std::function<void(size_t part, size_t width)>	NodeFunction;
+
+private:
+	struct Node{
+		NodeFunction			function;
+		size_t					width;
+		TaskPriority			priority;
+		std::vector<NodeID>		successors;
+		uint32_t				dependencies;
+		size_t					firstTask;				//     m_tasks 
+	};
+
+	JobGraph(const JobGraph&) = delete;
+	JobGraph& operator=(const JobGraph&) = delete;
+
+public:
+	JobGraph();
+	~JobGraph();												//   
+
+//      ;    Compile
+	NodeID	AddNode(NodeFunction function, size_t width=1, TaskPriority priority=TP_NORMAL);
+	void	AddEdge(NodeID from, NodeID to);					// to    from
+
+	void	Compile();											// Exception::WrongState,     
+	void	Kick();												// Exception::WrongState,       
+	void	Wait() const;										//    ThreadManager'  ,  
+
+	bool	IsCompiled() const;
+	bool	IsCompleted() const;
+	size_t	GetNodeCount() const;
+	size_t	GetTaskCount() const;								//   
+	const std::vector<NodeID>&	GetOrder() const;				//   
+
+private:
+	void	RunPart(NodeID node, size_t part);
+	void	Release(NodeID node);
+
+private:
+	std::vector<Node>							m_nodes;
+	std::vector<NodeID>							m_order;
+	std::vector<NodeID>							m_roots;		//   
+	std::vector< TaskProxy<void> >				m_tasks;
+	std::unique_ptr<std::atomic<uint32_t>[]>	m_waiting;		//   
+	std::unique_ptr<std::atomic<size_t>[]>		m_pending;		//   
+	bool										m_compiled;
+
+	CompletionCounter							m_done;
+	std::atomic_bool							m_failed;
+	Spinlock									m_lock;			// m_exception
+	std::exception_ptr							m_exception;
+};
+
+}
+}
\ No newline at end of file
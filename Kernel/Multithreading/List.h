@@ -1,19 +1,23 @@
-/************************************************
-*				!!!! DELAYED !!!!				*
-*	-  	*
-*	  - 		*
-************************************************/
+/****************************************************************************
+*						  ;					*
+*	      ,			*
+*	 (for_each, find_if)   ;					*
+*	     ,    		*
+*	    (EpochManager),									*
+*	        ElementRef (HazardPointer);		*
+*	     ,  ,  		*
+*	 													*
+****************************************************************************/
 #pragma once
 
 #include "Multithreading.h"
 #include "Spinlock.h"
-#include "RWSpinlock.h"
-#include "..\Memory\Adapter.h"
-#include "..\Logging\LogManager.h"
+#include "EpochManager.h"
+#include "HazardPointer.h"
+#include "../Memory/PoolAllocator.h"
+#include "../Memory/Adapter.h"
 #include <atomic>
 #include <mutex>
-#include <random>
-#include <algorithm>
 
 
 namespace RGE
@@ -23,307 +27,227 @@ namespace Multithreading
 
 template <class T>
 class List{
-public:
-	template <class U>
+private:
 	struct Node{
-		Node(){
-			next = prev = nullptr;
-			lock.SetSleepTime(5);
-			deleteThis.store(false);
-			refCount.store(0);
+		Node(const T& val) : object(val), next(nullptr), prev(nullptr){
+			removed.store(false);
 		}
 
-		U							object;
-		Node*						next;
-		Node*						prev;
-		mutable RWSpinlock			lock;
-		mutable std::atomic_bool	deleteThis;
-		mutable std::atomic_int		refCount;
+		T							object;
+		std::atomic<Node*>			next;				//   ,   
+		Node*						prev;				//   
+		std::atomic_bool			removed;
 	};
 
+//  ; ,       
+	struct NodePool{
+		NodePool(uint32_t chunkCount) : allocator(chunkCount){
+			refs.store(1);
+		}
+
+		void AddRef(){
+			refs.fetch_add(1, std::memory_order_relaxed);
+		}
+		void Release(){
+			if(refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				delete this;
+		}
+
+		Memory::PoolAllocator<Node>		allocator;
+		std::atomic<uint32_t>			refs;
+	};
+
+	typedef std::lock_guard<Spinlock>	WriteGuard;
+
+public:
+//    ,       
 	class ElementRef{
 		friend class List;
 
 	public:
-		ElementRef() : m_node(nullptr){}
-		ElementRef(Node<T>* node) : m_node(node){}
-		ElementRef(const ElementRef& ref) : m_node(ref.m_node){
-			this->AddRef();
+		ElementRef() : m_node(nullptr), m_hazard(nullptr){}
+		ElementRef(const ElementRef& ref) : m_node(ref.m_node), m_hazard(nullptr){
+			m_hazard.Set(m_node);
 		}
-		ElementRef(ElementRef&& ref) : m_node(ref.m_node){
+		ElementRef(ElementRef&& ref) : m_node(ref.m_node), m_hazard(nullptr){
+			m_hazard = std::move(ref.m_hazard);				//  : ref   
 			ref.m_node = nullptr;
 		}
-		~ElementRef(){
-			this->Release();
-		}
+		~ElementRef(){}
 
 
 		void Release(){
-			if(m_node){
-				m_node->refCount--;
-				m_node = nullptr;
-			}
+			m_node = nullptr;
+			m_hazard.Reset();
 		}
 
-		void Reset(Node<T>* node){
-			this->Release();
-			m_node = node;
-			AddRef();
+		bool IsRemoved() const{
+			return m_node == nullptr || m_node->removed.load();
 		}
 
 
-		T& operator->(){ return m_node->object; }
-		const T& operator->() const{ return m_node->object; }
-		bool operator()() const{ return m_node != nullptr; }
+		T& operator*() const{ return m_node->object; }
+		T* operator->() const{ return &m_node->object; }
+		explicit operator bool() const{ return m_node != nullptr; }
 
 		ElementRef& operator=(const ElementRef& ref){
 			if(this != &ref){
-				this->Release();
 				m_node = ref.m_node;
-				AddRef();
+				m_hazard.Set(m_node);
+			}
+			return *this;
+		}
+
+		ElementRef& operator=(ElementRef&& ref){
+			if(this != &ref){
+				Release();
+				m_node = ref.m_node;
+				m_hazard = std::move(ref.m_hazard);
+				ref.m_node = nullptr;
 			}
 			return *this;
 		}
 
 	private:
-		void AddRef(){
-			if(m_node)
-				m_node->refCount++;
+	//    :      
+		explicit ElementRef(Node* node) : m_node(node), m_hazard(nullptr){
+			m_hazard.Set(node);
 		}
 
 	private:
-		Node<T>*	m_node;
+		Node*			m_node;
+		HazardPointer	m_hazard;			//       
 	};
 
-public:
-	List(){
-		RGE_Throw(Exception::NotImplemented, "Implementation of RGE::Multithreading::List is delayed. Use SafeConatiner<std::list> instead");
-
-		m_end = Memory::CreateNew<Node<T>>(m_pool);
-		m_front = m_end;
-		m_back = m_end;
-
-		m_maxSleepTime = 5;
-		m_globalLock.set_sleep_time(5);
+private:
+	List(const List&) = delete;
+	List& operator=(const List&) = delete;
 
-		m_pushLogHandle = Logging::LogManager::Instance().CreateLog("ListDebug_push", Logging::LT_File);
-		m_popLogHandle = Logging::LogManager::Instance().CreateLog("ListDebug_pop", Logging::LT_File);
+public:
+	List(uint32_t poolChunkCount = 64) : m_pool(new NodePool(poolChunkCount)), m_tail(nullptr){
+		m_head.store(nullptr);
+		m_size.store(0);
 	}
 
+//     ,   Unlink:      ElementRef;
+//     -      
 	~List(){
-		while(!empty())
-			pop_front();
-		Memory::Delete(m_pool, m_end);
+		Node* node = m_head.load();
+		while(node != nullptr){
+			Node* next = node->next.load();
+			Retire(node);
+			node = next;
+		}
+		m_pool->Release();
 	}
 
-	//TODO:
-	ElementRef find_if(std::function<bool(const T&)> pred){
-	}
-	bool remove(ElementRef& ref){
-	}
-	void for_each(std::function<void(const T&)> oper){
+
+	void push_front(const T& val){
+		Node* newNode = Memory::CreateNew<Node>(m_pool->allocator, val);
+
+		WriteGuard lock(m_writeLock);
+		Node* head = m_head.load(std::memory_order_relaxed);
+		newNode->next.store(head, std::memory_order_relaxed);
+		if(head)	head->prev = newNode;
+		else		m_tail = newNode;
+		m_head.store(newNode, std::memory_order_release);
+		m_size++;
 	}
 
 	void push_back(const T& val){
-		Node<T>* newNode = Memory::CreateNew<Node<T>>(m_pool);
-		newNode->object = val;
-		newNode->lock.LockWrite();
-
-		std::lock_guard<Spinlock> lock(m_globalLock);
-
-		//      m_end  m_back
-		while(true){
-			if(m_end->lock.TryLockWrite()){
-				if(!empty() && !m_back.load()->lock.TryLockWrite()){
-					m_end->lock.UnlockWrite();
-				}
-				else break;
-			}
-
-			std::this_thread::sleep_for(GenRandomTime(m_maxSleepTime));
-		}
+		Node* newNode = Memory::CreateNew<Node>(m_pool->allocator, val);
 
-		newNode->prev = m_end->prev;
-		newNode->next = m_end;
-		m_end->prev = newNode;
-
-		if(!empty())	m_back.load()->next = newNode;
-		else			m_front = newNode;
-		m_back = newNode;
+		WriteGuard lock(m_writeLock);
+		newNode->prev = m_tail;
+		if(m_tail)	m_tail->next.store(newNode, std::memory_order_release);
+		else		m_head.store(newNode, std::memory_order_release);
+		m_tail = newNode;
 		m_size++;
-
-		//  
-		if(m_back.load()->prev)
-			m_back.load()->prev->lock.UnlockWrite();
-		m_back.load()->lock.UnlockWrite();
-		m_back.load()->next->lock.UnlockWrite();
 	}
 
-	void pop_back(){
-		while(!TryLockNodes(m_end, m_back, m_back.load()->prev)){
-			if(empty())	return;
-			std::this_thread::sleep_for(GenRandomTime(m_maxSleepTime));
-		}
-		m_size--;
-
-		Node* tmp = m_back;
-		m_end->prev = m_back.load()->prev;
-
-		//    
-		if(empty()){
-			m_front = m_end;
-			m_back = m_end;
-		}
-		else{
-			m_back = m_back.load()->prev;
-			m_back.load()->next = m_end;
-			m_end->lock.UnlockWrite();
-		}
-		m_back.load()->lock.UnlockWrite();
-
-		Memory::Delete(m_pool, tmp);
+	void pop_front(){
+		WriteGuard lock(m_writeLock);
+		Node* head = m_head.load(std::memory_order_relaxed);
+		if(head)
+			Unlink(head);
 	}
 
-	bool pop_back(T* val){
-		while(!TryLockNodes(m_end, m_back, m_back.load()->prev)){
-			if(empty())	return false;
-			std::this_thread::sleep_for(GenRandomTime(m_maxSleepTime));
-		}
-		m_size--;
-
-		Node* tmp = m_back;
-		*val = m_back.load()->object;
-		m_end->prev = m_back.load()->prev;
-
-		//    
-		if(empty()){
-			m_front = m_end;
-			m_back = m_end;
-		}
-		else{
-			m_back = m_back.load()->prev;
-			m_back.load()->next = m_end;
-			m_end->lock.UnlockWrite();
-		}
-		m_back.load()->lock.UnlockWrite();
+	bool pop_front(T* val){
+		WriteGuard lock(m_writeLock);
+		Node* head = m_head.load(std::memory_order_relaxed);
+		if(head == nullptr)
+			return false;
 
-		Memory::Delete(m_pool, tmp);
+		*val = head->object;
+		Unlink(head);
 		return true;
 	}
 
-
-	T front() const{
-		return T(*begin());
+	void pop_back(){
+		WriteGuard lock(m_writeLock);
+		if(m_tail)
+			Unlink(m_tail);
 	}
 
-	void push_front(const T& val){
-		Node<T>* newNode = Memory::CreateNew<Node<T>>(m_pool);
-		newNode->object = val;
-		newNode->lock.LockWrite();
+	bool pop_back(T* val){
+		WriteGuard lock(m_writeLock);
+		if(m_tail == nullptr)
+			return false;
 
-		RGE_LogDebug(m_pushLogHandle, "push_front: Trying to get write lock");
-		while(!m_front.load()->lock.TryLockWrite())
-			std::this_thread::sleep_for(GenRandomTime(m_maxSleepTime));
-		RGE_LogDebug(m_pushLogHandle, "push_front: m_front (%p) locked for writing", m_front.load());
+		*val = m_tail->object;
+		Unlink(m_tail);
+		return true;
+	}
 
-		newNode->next = m_front;
-		m_front.load()->prev = newNode;
-		m_front = newNode;
 
-		if(empty())
-			m_back = newNode;
-		m_size++;
+//  ,   pred  true;  ,   
+	template <class Pred>
+	ElementRef find_if(Pred pred) const{
+		EpochGuard guard;
 
-		RGE_LogDebug(m_pushLogHandle, "push_front: Value %u is pushed_front: size = %u m_front = %p(%i), m_front->next = %p(%i)",
-			val, m_size.load(), m_front.load(), m_front.load()->lock.IsLockedWrite(),
-			m_front.load()->next, m_front.load()->next->lock.IsLockedWrite());
+		for(Node* node = m_head.load(std::memory_order_acquire); node != nullptr; node = node->next.load(std::memory_order_acquire))
+			if(!node->removed.load(std::memory_order_relaxed) && pred(node->object))
+				return ElementRef(node);
+		return ElementRef();
+	}
 
-		m_front.load()->next->lock.UnlockWrite();
-		m_front.load()->lock.UnlockWrite();
+//    ,  oper  true
+	template <class Operation>
+	Operation for_each(Operation oper) const{
+		EpochGuard guard;
 
-		RGE_LogDebug(m_pushLogHandle, "push_front: nodes unlocked: %p -> %p", m_front.load(), m_front.load()->next);
+		for(Node* node = m_head.load(std::memory_order_acquire); node != nullptr; node = node->next.load(std::memory_order_acquire))
+			if(!node->removed.load(std::memory_order_relaxed) && !oper(node->object))
+				break;
+		return oper;
 	}
 
-	void pop_front(){
-		while(!TryLockNodes(m_front, m_front.load()->next)){
-			if(empty())	return;
-			std::this_thread::sleep_for(GenRandomTime(m_maxSleepTime));
-		}
-		m_size--;
-
-		Node<T>* tmp = m_front;
-		m_front = m_front.load()->next;
-		m_front.load()->prev = nullptr;
+// false,     
+	bool remove(ElementRef& ref){
+		if(!ref)	return false;
 
-		if(m_front == m_end)
-			m_back = m_end;
+		WriteGuard lock(m_writeLock);
+		if(ref.m_node->removed.load(std::memory_order_relaxed))
+			return false;
 
-		m_front.load()->lock.UnlockWrite();
-		Memory::Delete(m_pool, tmp);
+		Unlink(ref.m_node);
+		return true;
 	}
 
-	int LockedNodesCount(){
-		int count = 0;
-		Node<T>* curNode = m_front;
-		while(curNode != m_end){
-			if(curNode->lock.IsLockedWrite())
-				count++;
-			curNode = curNode->next;
-		}
-		return count;
+	bool try_erase(const T& val){
+		return remove_first_if([&](const T& elem){ return elem == val; });
 	}
 
-	bool pop_front(T* val){
-		RGE_LogDebug(m_popLogHandle, "pop_front: Trying to get write locks");
-
-		Node<T>* tmp;				//DEBUG
-		int repeats = 0;
-		while(!TryLockNodes(m_front, m_front.load()->next)){
-			tmp = m_front;
-			if(empty())	return false;
-			std::this_thread::sleep_for(GenRandomTime(m_maxSleepTime));
-
-			repeats++;
-		}
-		m_size--;
-
-		RGE_LogDebug(m_popLogHandle, "pop_front: Lock had been gotten for %p(%i) -> %p(%i) with %i reps and locked nodes count is %i of %u",
-			m_front.load(), m_front.load()->lock.IsLockedWrite(),
-			m_front.load()->next, m_front.load()->next->lock.IsLockedWrite(),
-			repeats, LockedNodesCount(), m_size.load());
-
-		*val = m_front.load()->object;
-		tmp = m_front;
-		m_front = m_front.load()->next;
-		m_front.load()->prev = tmp->prev;
-
-		if(m_front == m_end)
-			m_back = m_end;
-
-		try{
-			m_front.load()->lock.UnlockWrite();
-			Memory::Delete(m_pool, tmp);
-			if(!empty()){
-				RGE_LogDebug(m_popLogHandle, "pop_front: Value %u is popped: size = %u, m_front = %p(%i), m_front->next = %p(%i)",
-					*val, m_size.load(), m_front.load(), m_front.load()->lock.IsLockedWrite(),
-					m_front.load()->next, m_front.load()->next->lock.IsLockedWrite());
+	template <class Pred>
+	bool remove_first_if(Pred pred){
+		WriteGuard lock(m_writeLock);
+		for(Node* node = m_head.load(std::memory_order_relaxed); node != nullptr; node = node->next.load(std::memory_order_relaxed)){
+			if(pred(node->object)){
+				Unlink(node);
+				return true;
 			}
-			else{
-				RGE_LogDebug(m_popLogHandle, "pop_front: Value %u is popped: size = %u, m_front = %p(%i), m_front->next = nullptr",
-					*val, m_size.load(), m_front.load(), m_front.load()->lock.IsLockedWrite());
-			}
-		}
-		catch(Exception::BaseException& e){
-			tmp = m_front;
-			int cnt = LockedNodesCount();
-
-			RGE_LogDebug(m_popLogHandle, "pop_front: %s: m_front = %p, locked nodes count is %i of %u",
-				e.What(), m_front.load(), cnt, m_size.load());
-
-			throw e;
 		}
-
-		return true;
+		return false;
 	}
 
 
@@ -340,58 +264,47 @@ public:
 	}
 
 private:
-	//      pos 
-	/*	void Insert(ListIterator& pos, const T& val){
-
-	}
+//    ; node->next  ,  ,   ,   
+	void Unlink(Node* node){
+		Node* next = node->next.load(std::memory_order_relaxed);
 
-	//   pos  
-	void Delete(ListIterator& pos){
+		if(node->prev)	node->prev->next.store(next, std::memory_order_release);
+		else			m_head.store(next, std::memory_order_release);
 
-	}*/
+		if(next)		next->prev = node->prev;
+		else			m_tail = node->prev;
 
-	//   2  3    .     ,    
-	bool TryLockNodes(Node<T>* node1, Node<T>* node2, Node<T>* node3 = nullptr) const{
-		if(node1 == nullptr || node2 == nullptr)	return false;
-
-		if(node1->lock.TryLockWrite()){
-			if(node2->lock.TryLockWrite()){
-				if(node3 == nullptr || node3->lock.TryLockWrite())
-					return true;										//    
-
-				node2->lock.UnlockWrite();								//     
-			}
-			node1->lock.UnlockWrite();									//     
-		}
+		m_size--;
+		Retire(node);
+	}
 
-		return false;
+	void Retire(Node* node){
+		node->removed.store(true);
+		m_pool->AddRef();
+		RetiredObject obj = { node, &RetireToHazardDomain, m_pool };
+		EpochManager::Instance().Retire(obj);
 	}
 
-	//TODO:  -     ,    
-	std::chrono::milliseconds GenRandomTime(uint32_t maxSleepTime) const{
-		std::uniform_int_distribution<uint32_t>		randomTime(1, maxSleepTime);
-		std::default_random_engine					engine;
+//     ,       ElementRef
+	static void RetireToHazardDomain(void* node, void* pool){
+		RetiredObject obj = { node, &FreeNode, pool };
+		HazardPointerDomain::Instance().Retire(obj);
+	}
 
-		return std::chrono::milliseconds(randomTime(engine));
+	static void FreeNode(void* node, void* pool){
+		NodePool* nodePool = static_cast<NodePool*>(pool);
+		Memory::Delete(nodePool->allocator, static_cast<Node*>(node));
+		nodePool->Release();
 	}
 
 private:
-	static Memory::PoolAllocator<Node<T>>	m_pool;
-
-	//DEBUG
-	Logging::LogHandle			m_pushLogHandle;
-	Logging::LogHandle			m_popLogHandle;
-
-	Spinlock					m_globalLock;
-	std::atomic<Node<T>*>		m_front;
-	std::atomic<Node<T>*>		m_back;
-	Node<T>*					m_end;						//      
-	std::atomic<size_t>			m_size;
-	uint32_t					m_maxSleepTime;
-};
+	NodePool*						m_pool;
+	Spinlock						m_writeLock;
 
-template <class T>
-Memory::PoolAllocator< typename List<T>::Node<T> >	List<T>::m_pool(100, 4);
+	std::atomic<Node*>				m_head;
+	Node*							m_tail;					//   
+	std::atomic<size_t>				m_size;
+};
 
 }
-}
\ No newline at end of file
+}
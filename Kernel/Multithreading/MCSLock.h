@@ -0,0 +1,125 @@
+/****************************************************************************
+*	  MCS:      		*
+*	 ,      -;		*
+*	      (. MCSLock::Guard);			*
+*	       				*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Backoff.h"
+#include "../Platform/Settings.h"
+#include <atomic>
+#include <cstdint>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class MCSLock{
+private:
+	enum NodeState : uint32_t{
+		NS_WAITING = 0,
+		NS_GRANTED,
+		NS_PARKED									//   ,   
+	};
+
+	MCSLock(const MCSLock&) = delete;
+	MCSLock& operator=(const MCSLock&) = delete;
+
+public:
+	class Node{
+		friend class MCSLock;
+	public:
+		Node(){
+			m_next.store(nullptr);
+			m_state.store(NS_WAITING);
+		}
+
+	private:
+		std::atomic<Node*>		m_next;
+		std::atomic<uint32_t>	m_state;
+		uint8_t					m_pad[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<Node*>) - sizeof(std::atomic<uint32_t>)];
+	};
+
+	class Guard{
+	private:
+		Guard(const Guard&) = delete;
+		Guard& operator=(const Guard&) = delete;
+
+	public:
+		Guard(MCSLock& lock) : m_lock(lock){
+			m_lock.lock(m_node);
+		}
+		~Guard(){
+			m_lock.unlock(m_node);
+		}
+
+	private:
+		MCSLock&	m_lock;
+		Node		m_node;
+	};
+
+public:
+	MCSLock(uint32_t maxPauseCount = 64) : m_maxPauseCount(maxPauseCount){
+		m_tail.store(nullptr);
+	}
+	~MCSLock(){}
+
+	void lock(Node& node){
+		node.m_next.store(nullptr, std::memory_order_relaxed);
+		node.m_state.store(NS_WAITING, std::memory_order_relaxed);
+
+		Node* prev = m_tail.exchange(&node, std::memory_order_acq_rel);
+		if(prev == nullptr)
+			return;
+		prev->m_next.store(&node, std::memory_order_release);
+
+		Backoff backoff(m_maxPauseCount);
+		while(node.m_state.load(std::memory_order_acquire) != NS_GRANTED){
+			if(!backoff.IsSaturated()){
+				backoff.Pause();
+				continue;
+			}
+
+			uint32_t expected = NS_WAITING;
+			if(node.m_state.compare_exchange_strong(expected, NS_PARKED, std::memory_order_acquire))
+				node.m_state.wait(NS_PARKED, std::memory_order_acquire);
+		}
+	}
+
+	bool try_lock(Node& node){
+		node.m_next.store(nullptr, std::memory_order_relaxed);
+		Node* expected = nullptr;
+		return m_tail.compare_exchange_strong(expected, &node, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	void unlock(Node& node){
+		Node* next = node.m_next.load(std::memory_order_acquire);
+		if(next == nullptr){
+			Node* expected = &node;
+			if(m_tail.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed))
+				return;
+
+		//      ,       
+			while((next = node.m_next.load(std::memory_order_acquire)) == nullptr)
+				RGE_CPU_RELAX();
+		}
+
+		if(next->m_state.exchange(NS_GRANTED, std::memory_order_release) == NS_PARKED)
+			next->m_state.notify_one();
+	}
+
+	bool is_locked() const{
+		return m_tail.load(std::memory_order_relaxed) != nullptr;
+	}
+
+private:
+	std::atomic<Node*>		m_tail;
+	uint32_t				m_maxPauseCount;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+/****************************************************************
+*		 lock-free  ( ,		*
+*		 )     			*
+*	    ( . );		*
+*	    ;  		*
+*				try_push  false						*
+****************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "../Platform/Settings.h"
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+template <class T>
+class MPMCQueue{
+private:
+	struct Cell{
+		std::atomic<size_t>		sequence;		//  :        
+		T						data;
+	};
+
+private:
+	MPMCQueue(const MPMCQueue&) = delete;
+	MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+public:
+	explicit MPMCQueue(size_t capacity = 1024){
+		size_t realCapacity = 2;
+		while(realCapacity < capacity)
+			realCapacity <<= 1;
+
+		m_mask	=	realCapacity - 1;
+		m_cells	=	new Cell[realCapacity];
+		for(size_t i=0; i<realCapacity; i++)
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+
+		m_enqueuePos.store(0, std::memory_order_relaxed);
+		m_dequeuePos.store(0, std::memory_order_relaxed);
+	}
+
+	~MPMCQueue(){
+		delete[] m_cells;
+	}
+
+
+	bool try_push(const T& val){
+		return Emplace(val);
+	}
+
+	bool try_push(T&& val){
+		return Emplace(std::move(val));
+	}
+
+	bool try_pop(T* elem){
+		Cell* cell;
+		size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+		while(true){
+			cell = &m_cells[pos & m_mask];
+			size_t	 seq = cell->sequence.load(std::memory_order_acquire);
+			intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+			if(dif == 0){
+				if(m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if(dif < 0)
+				return false;											//  
+			else
+				pos = m_dequeuePos.load(std::memory_order_relaxed);		//    
+		}
+
+		*elem = std::move(cell->data);
+		cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+		return true;
+	}
+
+
+//  :      
+	size_t size() const{
+		size_t enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+		size_t dequeuePos = m_dequeuePos.load(std::memory_order_relaxed);
+		return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+	}
+
+	bool empty() const{
+		return size() == 0;
+	}
+
+	size_t capacity() const{
+		return m_mask + 1;
+	}
+
+private:
+	template <class U>
+	bool Emplace(U&& val){
+		Cell* cell;
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+		while(true){
+			cell = &m_cells[pos & m_mask];
+			size_t	 seq = cell->sequence.load(std::memory_order_acquire);
+			intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+			if(dif == 0){
+				if(m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if(dif < 0)
+				return false;											//  
+			else
+				pos = m_enqueuePos.load(std::memory_order_relaxed);		//    
+		}
+
+		cell->data = std::forward<U>(val);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+//        -,      
+	uint8_t					m_pad0[RGE_CACHE_LINE_SIZE];
+	std::atomic<size_t>		m_enqueuePos;
+	uint8_t					m_pad1[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t>		m_dequeuePos;
+	uint8_t					m_pad2[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+	Cell*					m_cells;
+	size_t					m_mask;
+};
+
+}
+}
\ No newline at end of file
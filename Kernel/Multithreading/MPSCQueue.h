@@ -0,0 +1,204 @@
+/****************************************************************
+*		 lock-free  ( ,		*
+*		 )   : 			*
+*	   CAS'   		*
+*	    ; 		*
+*	     CAS 				*
+*	    ; push_n				*
+*	    CAS;   		*
+*	 ;  Blocking=true push/pop  wait_*			*
+*	  futex (EventCount)								*
+****************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "EventCount.h"
+#include "../Platform/Settings.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+template <class T, bool Blocking = false>
+class MPSCQueue{
+private:
+	struct Cell{
+		std::atomic<size_t>		sequence;		// pos + 1 -     pos
+		T						data;
+	};
+
+private:
+	MPSCQueue(const MPSCQueue&) = delete;
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+public:
+	explicit MPSCQueue(size_t capacity = 1024){
+		size_t realCapacity = 2;
+		while(realCapacity < capacity)
+			realCapacity <<= 1;
+
+		m_mask	=	realCapacity - 1;
+		m_cells	=	new Cell[realCapacity];
+		for(size_t i=0; i<realCapacity; i++)
+			m_cells[i].sequence.store(0, std::memory_order_relaxed);
+
+		m_tail.store(0, std::memory_order_relaxed);
+		m_head.store(0, std::memory_order_relaxed);
+	}
+
+	~MPSCQueue(){
+		delete[] m_cells;
+	}
+
+
+//  
+	bool try_push(const T& val){
+		size_t pos;
+		if(Reserve(1, pos) == 0)
+			return false;												//  
+		Publish(pos, val);
+		NotifyReader();
+		return true;
+	}
+
+	bool try_push(T&& val){
+		size_t pos;
+		if(Reserve(1, pos) == 0)
+			return false;
+		Publish(pos, std::move(val));
+		NotifyReader();
+		return true;
+	}
+
+//     ,   
+	size_t push_n(const T* items, size_t count){
+		size_t pos;
+		count = Reserve(count, pos);
+		for(size_t i=0; i<count; i++)
+			Publish(pos + i, items[i]);
+
+		if(count != 0)
+			NotifyReader();
+		return count;
+	}
+
+//  -;    ,     
+	bool try_pop(T* elem){
+		return pop_n(elem, 1) == 1;
+	}
+
+	size_t pop_n(T* items, size_t maxCount){
+		size_t head = m_head.load(std::memory_order_relaxed);
+		size_t count = 0;
+		for(; count<maxCount; count++){
+			Cell& cell = m_cells[(head + count) & m_mask];
+			if(cell.sequence.load(std::memory_order_acquire) != head + count + 1)
+				break;
+			items[count] = std::move(cell.data);
+		}
+
+		if(count != 0){
+			m_head.store(head + count, std::memory_order_release);
+			NotifyWriters();
+		}
+		return count;
+	}
+
+
+//   ( Blocking)
+	template <class U>
+	void push(U&& val){
+		static_assert(Blocking, "MPSCQueue: blocking push requires Blocking=true");
+		while(!try_push(std::forward<U>(val)))
+			wait_not_full();
+	}
+
+	void pop(T* elem){
+		static_assert(Blocking, "MPSCQueue: blocking pop requires Blocking=true");
+		while(!try_pop(elem))
+			wait_not_empty();
+	}
+
+//   ,   size():       
+	void wait_not_empty(){
+		static_assert(Blocking, "MPSCQueue: waiting requires Blocking=true");
+		m_notEmpty.Await([this](){
+			size_t head = m_head.load(std::memory_order_relaxed);
+			return m_cells[head & m_mask].sequence.load(std::memory_order_acquire) == head + 1;
+		});
+	}
+
+	void wait_not_full(){
+		static_assert(Blocking, "MPSCQueue: waiting requires Blocking=true");
+		m_notFull.Await([this](){ return size() < capacity(); });
+	}
+
+
+//  :      
+	size_t size() const{
+		size_t tail = m_tail.load(std::memory_order_acquire);
+		size_t head = m_head.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+
+	bool empty() const{
+		return size() == 0;
+	}
+
+	size_t capacity() const{
+		return m_mask + 1;
+	}
+
+private:
+//   count  ,   pos; 0 -  
+	size_t Reserve(size_t count, size_t& pos){
+		pos = m_tail.load(std::memory_order_relaxed);
+		while(true){
+			size_t head = m_head.load(std::memory_order_acquire);
+			size_t free = m_mask + 1 - (pos - head);
+			size_t reserved = std::min(count, free);
+			if(reserved == 0)
+				return 0;
+			if(m_tail.compare_exchange_weak(pos, pos + reserved, std::memory_order_relaxed))
+				return reserved;
+		}
+	}
+
+	template <class U>
+	void Publish(size_t pos, U&& val){
+		Cell& cell = m_cells[pos & m_mask];
+		cell.data = std::forward<U>(val);
+		cell.sequence.store(pos + 1, std::memory_order_release);
+	}
+
+	void NotifyReader(){
+		if constexpr(Blocking)
+			m_notEmpty.NotifyOne();
+	}
+
+	void NotifyWriters(){
+		if constexpr(Blocking)
+			m_notFull.NotifyAll();
+	}
+
+private:
+//        -,      
+	uint8_t					m_pad0[RGE_CACHE_LINE_SIZE];
+	std::atomic<size_t>		m_tail;
+	uint8_t					m_pad1[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t>		m_head;
+	uint8_t					m_pad2[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+	Cell*					m_cells;
+	size_t					m_mask;
+	EventCount				m_notEmpty;
+	EventCount				m_notFull;
+};
+
+}
+}
\ No newline at end of file
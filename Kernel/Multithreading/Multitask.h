@@ -8,6 +8,8 @@
 
 #include "Multithreading.h"
 #include "Task.h"
+#include "TaskPool.h"
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -26,8 +28,11 @@ public:
 	Multitask(std::function<T(int, int)> f, int n){
 		m_taskCount = n;
 		m_tasks.resize(m_taskCount);
+
+	//     :         
+		auto func = std::make_shared< std::function<T(int, int)> >(std::move(f));
 		for(int i=0; i<m_taskCount; i++)
-			m_tasks[i] = std::make_shared<Task<T>>( std::bind(f, i, m_taskCount) );			//TODO:     
+			m_tasks[i] = MakeTask<T>( [func, i, n](){ return (*func)(i, n); } );
 	}
 
 	Multitask(const Multitask& multitask){
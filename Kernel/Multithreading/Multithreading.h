@@ -4,6 +4,7 @@
 #pragma once
 
 #include "..\KernelDLL.h"
+#include <cstddef>
 
 
 namespace RGE
@@ -13,28 +14,96 @@ namespace Multithreading
 //==================
 //		Locks
 //==================
+	class				Backoff;
 	class				Spinlock;
+	class				TicketLock;
+	class				MCSLock;
 	class KERNEL_API	IReadWriteLock;
 	class KERNEL_API	RWSpinlock;		
+	class KERNEL_API	BravoRWLock;
 	class				ReadLockGuard;
 	class				WriteLockGuard;
+	class				AdaptiveSpin;
+	class				EventCount;
+	class				CompletionCounter;
+
+//==================
+//	  Reclamation
+//==================
+	struct				RetiredObject;
+	class KERNEL_API	EpochManager;
+	class				EpochGuard;
+	class KERNEL_API	HazardPointerDomain;
+	class				HazardPointer;
 
 //==================
 //	  Structures
 //==================
 	template <class Container>	class	SafeContainer;
 	template <class T>			class	List;
+	template <class Container>	class	RcuContainer;
+	template <class T>			class	MPMCQueue;
+	template <class T, bool Blocking>	class	SPSCQueue;
+	template <class T, bool Blocking>	class	MPSCQueue;
+	template <class T>			class	SegmentedQueue;
+	template <class K, class V, class Hash, class KeyEqual>	class	ConcurrentHashMap;
 
 //==================
 //	Threads & Tasks
 //==================
 	class							ITask;
+	class							TaskBase;
 	template <typename T> 	class	Task; 
 	template <typename T>	class	Multitask;
 	template <typename T>	class	TaskProxy;
 	template <typename T>	class	MultitaskProxy;	
+	class							TaskBatchBase;
+	template <typename T>	class	TaskBatch;
+	template <typename T>	class	BatchProxy;
 	class KERNEL_API				Thread;
 	class KERNEL_API				ThreadManager;
+	class KERNEL_API				TaskPool;
+	template <class T>		class	TaskAllocator;
+	template <class Signature, size_t Capacity>	class	InplaceFunction;
+	struct							LogicalCpu;
+	class KERNEL_API				Topology;
+	struct							ScheduledTask;
+	struct							LatencyStats;
+	class KERNEL_API				SchedulingPolicy;
+	class KERNEL_API				Fiber;
+	class KERNEL_API				FiberScheduler;
+	struct							HistogramSnapshot;
+	class							LatencyHistogram;
+	struct							WorkerSnapshot;
+	class							WorkerStats;
+	struct KERNEL_API				SchedulerSnapshot;
+	struct							CancellationState;
+	class KERNEL_API				CancellationToken;
+	class KERNEL_API				CancellationSource;
+	class KERNEL_API				TaskGroup;
+	class KERNEL_API				JobGraph;
+	class							BlockingRegion;
+	class KERNEL_API				WorkerContext;
+
+//==================
+//	  Coroutines
+//==================
+	struct							Continuation;
+	class							ContinuationList;
+	class							IScheduler;
+	class							PromiseBase;
+	template <typename T>	class	Coroutine;
+	template <typename T>	class	TaskAwaiter;
+	template <typename T>	class	MultitaskAwaiter;
+	class							AsyncEvent;
+	class							Yield;
+	class							Delay;
+	class KERNEL_API				DelayQueue;
+	class KERNEL_API				TimerWheel;
+	struct							Timer;
+	class							TimerHandle;
+	template <typename T>	class	DelayedTaskProxy;
+	template <typename T>	class	Pipeline;
 
 }
 }
\ No newline at end of file
@@ -0,0 +1,256 @@
+/****************************************************************************
+*	:    ,   			*
+*	ThreadManager';      maxTokens 		*
+*	( ,       ), 		*
+*	 (T)     ;   		*
+*	   ,      		*
+*	 -   ,    , 		*
+*	;      		*
+*	,  -      			*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ThreadManager.h"
+#include "CompletionCounter.h"
+#include "Spinlock.h"
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+enum StageMode{
+	SM_PARALLEL = 0,
+	SM_SERIAL_IN_ORDER
+};
+
+
+// T     ;     
+template <typename T>
+class Pipeline{
+public:
+	typedef std::function<bool(T& item)>	SourceFunction;			// false -   
+	typedef std::function<void(T& item)>	StageFunction;
+
+private:
+	struct Token{
+		T				item;
+		uint64_t		seq;										//     
+	};
+
+	struct Stage{
+		StageMode		mode;
+		StageFunction	function;
+	};
+
+//   Run;   ,   
+	struct State{
+		struct SerialStage{
+			Spinlock				lock;
+			uint64_t				nextSeq;
+			bool					busy;
+			std::vector<Token*>		waiting;						//  seq   waiting[seq % maxTokens]
+		};
+
+		std::vector<Stage>			stages;
+		std::vector<SerialStage>	serial;							//     ,   
+		std::vector<Token>			tokens;
+		std::vector<Token*>			freeTokens;
+		SourceFunction				source;
+		TaskPriority				priority;
+
+		Spinlock					lock;							// freeTokens, nextSeq, inputActive, sourceDone
+		uint64_t					nextSeq;
+		bool						inputActive;
+		bool						sourceDone;
+
+		std::atomic_bool			failed;
+		std::exception_ptr			exception;						//     
+		CompletionCounter			completion;						//  +   
+	};
+
+	typedef std::shared_ptr<State>	StatePtr;
+
+public:
+	explicit Pipeline(size_t maxTokens) : m_maxTokens(maxTokens > 0 ? maxTokens : 1){}
+
+	Pipeline& AddStage(StageMode mode, StageFunction function){
+		m_stages.push_back(Stage{ mode, std::move(function) });
+		return *this;
+	}
+
+// ,          ;  
+//     ,      
+	void Run(SourceFunction source, TaskPriority priority=TP_NORMAL){
+		StatePtr state = std::make_shared<State>();
+		state->stages		= m_stages;
+		state->serial		= std::vector<typename State::SerialStage>(m_stages.size());
+		state->tokens		= std::vector<Token>(m_maxTokens);
+		state->source		= std::move(source);
+		state->priority		= priority;
+		state->nextSeq		= 0;
+		state->inputActive	= false;
+		state->sourceDone	= false;
+		state->failed.store(false);
+
+		for(auto& serial : state->serial){
+			serial.nextSeq	= 0;
+			serial.busy		= false;
+			serial.waiting.assign(m_maxTokens, nullptr);
+		}
+		for(auto& token : state->tokens)
+			state->freeTokens.push_back(&token);
+
+		state->completion.Add();
+		TryStartInput(state);
+		state->completion.Wait();
+
+		if(state->exception)
+			std::rethrow_exception(state->exception);
+	}
+
+	size_t GetMaxTokens() const{
+		return m_maxTokens;
+	}
+
+	size_t GetStageCount() const{
+		return m_stages.size();
+	}
+
+private:
+	static void Spawn(const StatePtr& state, std::function<void()> job){
+		ThreadManager::Instance().Execute<void>(std::move(job), state->priority);
+	}
+
+//     ,    completion  ,  -  Input/TryStartInput
+	static void Fail(State& state){
+		{
+			std::lock_guard<Spinlock> guard(state.lock);
+			if(!state.failed.exchange(true))
+				state.exception = std::current_exception();
+			if(state.inputActive || state.sourceDone)
+				return;
+			state.sourceDone = true;
+		}
+		state.completion.Done();
+	}
+
+//  :          
+	static void TryStartInput(const StatePtr& state){
+		bool failed;
+		{
+			std::lock_guard<Spinlock> guard(state->lock);
+			if(state->inputActive || state->sourceDone)
+				return;
+			failed = state->failed.load();
+			if(failed)
+				state->sourceDone = true;
+			else if(state->freeTokens.empty())
+				return;
+			else
+				state->inputActive = true;
+		}
+		if(failed)
+			state->completion.Done();
+		else
+			Spawn(state, [state](){ Input(state); });
+	}
+
+	static void Input(const StatePtr& state){
+		Token* token;
+		{
+			std::lock_guard<Spinlock> guard(state->lock);
+			token = state->freeTokens.back();
+			state->freeTokens.pop_back();
+		}
+
+		bool hasItem = false;
+		if(!state->failed.load()){
+			try{ hasItem = state->source(token->item); }
+			catch(...){ Fail(*state); }
+		}
+
+		{
+			std::lock_guard<Spinlock> guard(state->lock);
+			state->inputActive = false;
+			if(!hasItem){
+				state->sourceDone = true;
+				state->freeTokens.push_back(token);
+			}
+			else{
+				token->seq = state->nextSeq++;
+				state->completion.Add();
+			}
+		}
+
+		if(!hasItem){
+			state->completion.Done();
+			return;
+		}
+
+		TryStartInput(state);										//      
+		Process(state, token, 0);
+	}
+
+	static void Process(const StatePtr& state, Token* token, size_t first){
+		for(size_t i=first; i<state->stages.size(); i++){
+			Stage& stage = state->stages[i];
+			if(stage.mode == SM_PARALLEL){
+				Call(*state, stage, token);
+				continue;
+			}
+
+			typename State::SerialStage& serial = state->serial[i];
+			{
+				std::lock_guard<Spinlock> guard(serial.lock);
+				if(serial.busy || token->seq != serial.nextSeq){
+					serial.waiting[token->seq % serial.waiting.size()] = token;
+					return;
+				}
+				serial.busy = true;
+			}
+
+			Call(*state, stage, token);
+
+			Token* next;
+			{
+				std::lock_guard<Spinlock> guard(serial.lock);
+				serial.busy = false;
+				serial.nextSeq++;
+				Token*& slot = serial.waiting[serial.nextSeq % serial.waiting.size()];
+				next = slot;
+				slot = nullptr;
+			}
+			if(next != nullptr)
+				Spawn(state, [state, next, i](){ Process(state, next, i); });
+		}
+
+		{
+			std::lock_guard<Spinlock> guard(state->lock);
+			state->freeTokens.push_back(token);
+		}
+		TryStartInput(state);
+		state->completion.Done();
+	}
+
+	static void Call(State& state, Stage& stage, Token* token){
+		if(state.failed.load())
+			return;
+		try{ stage.function(token->item); }
+		catch(...){ Fail(state); }
+	}
+
+private:
+	std::vector<Stage>		m_stages;
+	size_t					m_maxTokens;
+};
+
+}
+}
\ No newline at end of file
@@ -6,9 +6,10 @@ namespace RGE
 namespace Multithreading
 {
 
-RWSpinlock::RWSpinlock(uint32_t sleepTime_ms){
-	m_sleepTime = std::chrono::milliseconds(sleepTime_ms);
+RWSpinlock::RWSpinlock(uint32_t maxPauseCount){
+	m_maxPauseCount = maxPauseCount;
 	m_lockValue.store(0);
+	m_waiters.store(0);
 }
 
 RWSpinlock::~RWSpinlock(){
@@ -17,13 +18,14 @@ RWSpinlock::~RWSpinlock(){
 
 
 void RWSpinlock::LockRead(){
+	Backoff backoff(m_maxPauseCount);
 	while(true){
-		while(m_lockValue & 0xFFF00000)								//    - 
-			std::this_thread::sleep_for(m_sleepTime);
+		WaitWhileSet(0xFFF00000, backoff);							//    - 
 			
 		if( !(++m_lockValue & 0xFFF00000) )							//       -  
 			return;
 		m_lockValue--;												//       
+		WakeWaiters();
 	}
 }
 
@@ -32,12 +34,14 @@ bool RWSpinlock::TryLockRead(){
 		return true;
 
 	m_lockValue--;
+	WakeWaiters();
 	return false;
 }
 
 void RWSpinlock::UnlockRead(){
 	RGE_Assert(m_lockValue & 0x000FFFFF, Exception::WrongState, "There are no read locks");
 	m_lockValue--;
+	WakeWaiters();
 }
 
 bool RWSpinlock::IsLockedRead() const{
@@ -46,17 +50,18 @@ bool RWSpinlock::IsLockedRead() const{
 
 
 void RWSpinlock::LockWrite(){
+	Backoff backoff(m_maxPauseCount);
 	while(true){
-		while(m_lockValue & 0xFFF00000)								//     - 
-			std::this_thread::sleep_for(m_sleepTime);
+		WaitWhileSet(0xFFF00000, backoff);							//     - 
 
 		m_lockValue += 0x00100000;
 		if( (m_lockValue & 0xFFF00000) == 0x00100000 ){
-			while(m_lockValue & 0x000FFFFF)							// ,    
-				std::this_thread::sleep_for(m_sleepTime);
+			backoff.Reset();
+			WaitWhileSet(0x000FFFFF, backoff);						// ,    
 			return;
 		}
 		m_lockValue -= 0x00100000;
+		WakeWaiters();
 	}
 }
 
@@ -69,14 +74,39 @@ bool RWSpinlock::TryLockWrite(){
 void RWSpinlock::UnlockWrite(){
 	RGE_Assert(m_lockValue & 0xFFF00000, Exception::WrongState, "There are no write locks");
 	m_lockValue -= 0x00100000;
+	WakeWaiters();
 }
 
 bool RWSpinlock::IsLockedWrite() const{
 	return (m_lockValue & 0xFFF00000) != 0;
 }
 
-void RWSpinlock::SetSleepTime(uint32_t sleepTime_ms){
-	m_sleepTime = std::chrono::milliseconds(sleepTime_ms);
+void RWSpinlock::SetMaxPauseCount(uint32_t maxPauseCount){
+	m_maxPauseCount = maxPauseCount;
+}
+
+
+//     :    , wait  ;
+// m_waiters   ,       
+void RWSpinlock::WaitWhileSet(uint32_t mask, Backoff& backoff){
+	uint32_t value = m_lockValue.load();
+	while(value & mask){
+		if(!backoff.IsSaturated())
+			backoff.Pause();
+		else{
+			m_waiters++;
+			value = m_lockValue.load();
+			if(value & mask)
+				m_lockValue.wait(value);
+			m_waiters--;
+		}
+		value = m_lockValue.load();
+	}
+}
+
+void RWSpinlock::WakeWaiters(){
+	if(m_waiters.load() != 0)
+		m_lockValue.notify_all();
 }
 
 }
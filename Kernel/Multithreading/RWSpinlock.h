@@ -1,12 +1,15 @@
 /****************************************
-*	-  -	*
+*	-  -;	*
+*	  			*
+*	 (Backoff),  	*
+*	  (std::atomic::wait)	*
 ****************************************/
 #pragma once
 
 #include "Multithreading.h"
+#include "Backoff.h"
 #include "../Exception/Exception.h"
 #include <atomic>
-#include <thread>
 
 
 namespace RGE
@@ -31,7 +34,7 @@ private:
 	RWSpinlock& operator=(const RWSpinlock&) = delete;
 
 public:
-	RWSpinlock(uint32_t sleepTime_ms = 0);
+	RWSpinlock(uint32_t maxPauseCount = 64);
 	~RWSpinlock();
 
 	void LockRead();
@@ -44,11 +47,16 @@ public:
 	void UnlockWrite();
 	bool IsLockedWrite() const;
 
-	void SetSleepTime(uint32_t sleepTime_ms);
+	void SetMaxPauseCount(uint32_t maxPauseCount);
+
+private:
+	void WaitWhileSet(uint32_t mask, Backoff& backoff);		// ,   m_lockValue   mask
+	void WakeWaiters();										//     m_lockValue
 
 private:
 	std::atomic<uint32_t>		m_lockValue;		// 12      ,  - 
-	std::chrono::milliseconds	m_sleepTime;
+	std::atomic<uint32_t>		m_waiters;			//  ;      
+	uint32_t					m_maxPauseCount;
 };
 
 
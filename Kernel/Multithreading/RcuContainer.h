@@ -0,0 +1,189 @@
+/****************************************************************************
+*	     (RCU,   ):	*
+*	       ,	*
+*	   ;								*
+*	   ,     ;		*
+*	    EpochManager,    		*
+*	   ;												*
+*	NOTE: Snapshot -   EpochManager:   			*
+*	 ,  ,    			*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Spinlock.h"
+#include "EpochManager.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+template <class Container>
+class RcuContainer{
+public:
+	using T				=	typename Container::value_type;
+
+private:
+	struct Version{
+		Version(){}
+		Version(const Container& cont) : data(cont){}
+		Version(Container&& cont) : data(std::move(cont)){}
+
+		Container		data;
+	};
+
+	typedef std::lock_guard<Spinlock>	WriteGuard;
+
+	RcuContainer(const RcuContainer&) = delete;
+	RcuContainer& operator=(const RcuContainer&) = delete;
+
+public:
+//   ;   ,   
+	class Snapshot{
+		friend class RcuContainer;
+	private:
+		Snapshot(const RcuContainer& cont){
+			m_data = &cont.m_current.load(std::memory_order_acquire)->data;
+		}
+
+		Snapshot(const Snapshot&) = delete;
+		Snapshot& operator=(const Snapshot&) = delete;
+
+	public:
+
+		const Container& operator*() const{
+			return *m_data;
+		}
+		const Container* operator->() const{
+			return m_data;
+		}
+
+	private:
+		EpochGuard					m_guard;
+		const Container*			m_data;
+	};
+
+public:
+	RcuContainer(){
+		m_current.store(new Version());
+	}
+	explicit RcuContainer(const Container& cont){
+		m_current.store(new Version(cont));
+	}
+	explicit RcuContainer(Container&& cont){
+		m_current.store(new Version(std::move(cont)));
+	}
+
+	~RcuContainer(){
+		delete m_current.load();
+	}
+
+
+//==================
+//	   
+//==================
+	Snapshot snapshot() const{
+		return Snapshot(*this);
+	}
+
+//   ,  oper  true
+	template <class Operation>
+	Operation for_each(Operation oper) const{
+		Snapshot snap(*this);
+		for(auto it = snap->begin(); it != snap->end() && oper(*it); ++it);
+		return oper;
+	}
+
+//   elem  ,   pred  true
+	template <class Pred>
+	bool find_if(Pred pred, T* elem) const{
+		Snapshot snap(*this);
+		for(auto it = snap->begin(); it != snap->end(); ++it){
+			if(pred(*it)){
+				*elem = *it;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t size() const{
+		return snapshot()->size();
+	}
+
+	bool empty() const{
+		return snapshot()->empty();
+	}
+
+
+//==================
+//	   
+//==================
+// modify    ;  modify  false,   
+	template <class Modifier>
+	bool update(Modifier modify){
+		WriteGuard guard(m_writeLock);
+
+		std::unique_ptr<Version> newVersion( new Version(m_current.load(std::memory_order_relaxed)->data) );
+		if(!modify(newVersion->data))
+			return false;
+
+		Publish(newVersion.release());
+		return true;
+	}
+
+	void assign(const Container& cont){
+		WriteGuard guard(m_writeLock);
+		Publish(new Version(cont));
+	}
+
+	void assign(Container&& cont){
+		WriteGuard guard(m_writeLock);
+		Publish(new Version(std::move(cont)));
+	}
+
+	void push_back(const T& val){
+		update([&val](Container& cont){ cont.push_back(val); return true; });
+	}
+
+	bool try_erase(const T& elem){
+		return update([&elem](Container& cont){
+			for(auto it = cont.begin(); it != cont.end(); ++it){
+				if(*it == elem){
+					cont.erase(it);
+					return true;
+				}
+			}
+			return false;
+		});
+	}
+
+	void clear(){
+		assign(Container());
+	}
+
+// ,      ,   ,   
+	void synchronize(){
+		EpochManager::Instance().Synchronize();
+	}
+
+private:
+//    
+	void Publish(Version* version){
+		Version* oldVersion = m_current.exchange(version, std::memory_order_acq_rel);
+		EpochManager::Instance().Retire(oldVersion);
+	}
+
+private:
+	std::atomic<Version*>			m_current;
+	Spinlock						m_writeLock;
+};
+
+}
+}
\ No newline at end of file
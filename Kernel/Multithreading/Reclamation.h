@@ -0,0 +1,52 @@
+/****************************************************************************
+*	     					*
+*	(EpochManager, HazardPointerDomain):   			*
+*	  ,   ;								*
+*	     ,    			*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "../Memory/IAllocator.h"
+#include "../Memory/Adapter.h"
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+struct RetiredObject{
+	typedef void (*Deleter)(void* ptr, void* context);
+
+	void*		ptr;
+	Deleter		deleter;
+	void*		context;						//   deleter (, )
+
+	void Free(){
+		deleter(ptr, context);
+	}
+};
+
+
+template <class T>
+RetiredObject MakeRetired(T* ptr){
+	RetiredObject obj;
+	obj.ptr		= ptr;
+	obj.deleter = [](void* p, void*){ delete static_cast<T*>(p); };
+	obj.context = nullptr;
+	return obj;
+}
+
+//       allocator; allocator   
+template <class T>
+RetiredObject MakeRetired(T* ptr, Memory::IAllocator& allocator){
+	RetiredObject obj;
+	obj.ptr		= ptr;
+	obj.deleter = [](void* p, void* alloc){ Memory::Delete(*static_cast<Memory::IAllocator*>(alloc), static_cast<T*>(p)); };
+	obj.context = &allocator;
+	return obj;
+}
+
+}
+}
\ No newline at end of file
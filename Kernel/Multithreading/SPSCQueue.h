@@ -0,0 +1,185 @@
+/****************************************************************
+*		 lock-free  ( ,			*
+*		 )   ;  		*
+*	      	*
+*	,      (); push_n/		*
+*	pop_n      ;			*
+*	    ;  Blocking=true	*
+*	push/pop  wait_*   futex (EventCount)			*
+****************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "EventCount.h"
+#include "../Platform/Settings.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+template <class T, bool Blocking = false>
+class SPSCQueue{
+private:
+	SPSCQueue(const SPSCQueue&) = delete;
+	SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+public:
+	explicit SPSCQueue(size_t capacity = 1024){
+		size_t realCapacity = 2;
+		while(realCapacity < capacity)
+			realCapacity <<= 1;
+
+		m_mask		=	realCapacity - 1;
+		m_buffer	=	new T[realCapacity];
+		m_head.store(0, std::memory_order_relaxed);
+		m_tail.store(0, std::memory_order_relaxed);
+		m_cachedHead = 0;
+		m_cachedTail = 0;
+	}
+
+	~SPSCQueue(){
+		delete[] m_buffer;
+	}
+
+
+//  -
+	bool try_push(const T& val){
+		return Emplace(val);
+	}
+
+	bool try_push(T&& val){
+		return Emplace(std::move(val));
+	}
+
+//   ,   
+	size_t push_n(const T* items, size_t count){
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		if(FreeSpace(tail) < count)
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+
+		count = std::min(count, FreeSpace(tail));
+		for(size_t i=0; i<count; i++)
+			m_buffer[(tail + i) & m_mask] = items[i];
+
+		if(count != 0){
+			m_tail.store(tail + count, std::memory_order_release);
+			NotifyReader();
+		}
+		return count;
+	}
+
+//  -
+	bool try_pop(T* elem){
+		return pop_n(elem, 1) == 1;
+	}
+
+	size_t pop_n(T* items, size_t maxCount){
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if(m_cachedTail - head < maxCount)
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+		size_t count = std::min(maxCount, m_cachedTail - head);
+		for(size_t i=0; i<count; i++)
+			items[i] = std::move(m_buffer[(head + i) & m_mask]);
+
+		if(count != 0){
+			m_head.store(head + count, std::memory_order_release);
+			NotifyWriter();
+		}
+		return count;
+	}
+
+
+//   ( Blocking)
+	template <class U>
+	void push(U&& val){
+		static_assert(Blocking, "SPSCQueue: blocking push requires Blocking=true");
+		while(!Emplace(std::forward<U>(val)))
+			wait_not_full();
+	}
+
+	void pop(T* elem){
+		static_assert(Blocking, "SPSCQueue: blocking pop requires Blocking=true");
+		while(!try_pop(elem))
+			wait_not_empty();
+	}
+
+	void wait_not_empty(){
+		static_assert(Blocking, "SPSCQueue: waiting requires Blocking=true");
+		m_notEmpty.Await([this](){ return !empty(); });
+	}
+
+	void wait_not_full(){
+		static_assert(Blocking, "SPSCQueue: waiting requires Blocking=true");
+		m_notFull.Await([this](){ return size() < capacity(); });
+	}
+
+
+//  ,       
+	size_t size() const{
+		size_t tail = m_tail.load(std::memory_order_acquire);
+		size_t head = m_head.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+
+	bool empty() const{
+		return size() == 0;
+	}
+
+	size_t capacity() const{
+		return m_mask + 1;
+	}
+
+private:
+	template <class U>
+	bool Emplace(U&& val){
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		if(FreeSpace(tail) == 0){
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+			if(FreeSpace(tail) == 0)
+				return false;											//  
+		}
+
+		m_buffer[tail & m_mask] = std::forward<U>(val);
+		m_tail.store(tail + 1, std::memory_order_release);
+		NotifyReader();
+		return true;
+	}
+
+	size_t FreeSpace(size_t tail) const{
+		return m_mask + 1 - (tail - m_cachedHead);
+	}
+
+	void NotifyReader(){
+		if constexpr(Blocking)
+			m_notEmpty.NotifyOne();
+	}
+
+	void NotifyWriter(){
+		if constexpr(Blocking)
+			m_notFull.NotifyOne();
+	}
+
+private:
+//        -,      
+	uint8_t					m_pad0[RGE_CACHE_LINE_SIZE];
+	std::atomic<size_t>		m_tail;
+	size_t					m_cachedHead;								//     
+	uint8_t					m_pad1[RGE_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+	std::atomic<size_t>		m_head;
+	size_t					m_cachedTail;
+	uint8_t					m_pad2[RGE_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+	T*						m_buffer;
+	size_t					m_mask;
+	EventCount				m_notEmpty;
+	EventCount				m_notFull;
+};
+
+}
+}
\ No newline at end of file
@@ -137,7 +137,7 @@ public:
 //   ,  oper  true
 	template <class Operation>
 	Operation for_each(Operation oper) const{
-		WriteLock lock(m_rwlock);
+		ReadLock lock(m_rwlock);
 		for(auto it = m_container.begin(); it != m_container.end() && oper(*it); ++it);
 		return oper;
 	}
@@ -0,0 +1,117 @@
+#include "SchedulingPolicy.h"
+#include <algorithm>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+SchedulingPolicy::SchedulingPolicy(){
+	m_size.store(0);
+	m_agingStep.store( std::chrono::duration_cast<IScheduler::Clock::duration>(std::chrono::milliseconds(50)).count() );
+	ResetLatency();
+}
+
+
+void SchedulingPolicy::Push(ScheduledTask&& entry){
+	if(entry.deadline != ScheduledTask::NO_DEADLINE){
+		m_deadlines.push_back(std::move(entry));
+		std::push_heap(m_deadlines.begin(), m_deadlines.end(), LaterDeadline());
+	}
+	else
+		m_queues[entry.priority].push_back(std::move(entry));
+	m_size++;
+}
+
+//       ,   -   ;
+//       ,  -    
+bool SchedulingPolicy::TryPop(ScheduledTask& entry){
+	IScheduler::Clock::time_point now = IScheduler::Clock::now();
+
+	int		best		= -1;
+	int64_t	bestLevel	= 0;
+	if(!m_deadlines.empty()){
+		best		= TP_COUNT;
+		bestLevel	= GetLevel(m_deadlines.front(), TP_COUNT, now);
+	}
+	for(int p = TP_COUNT - 1; p >= 0; p--){
+		if(m_queues[p].empty())
+			continue;
+
+		int64_t level = GetLevel(m_queues[p].front(), p, now);
+		if(best < 0 || level > bestLevel){
+			best		= p;
+			bestLevel	= level;
+		}
+	}
+
+	if(best < 0)
+		return false;
+
+	if(best == TP_COUNT){
+		std::pop_heap(m_deadlines.begin(), m_deadlines.end(), LaterDeadline());
+		entry = std::move(m_deadlines.back());
+		m_deadlines.pop_back();
+	}
+	else{
+		entry = std::move(m_queues[best].front());
+		m_queues[best].pop_front();
+	}
+	m_size--;
+	return true;
+}
+
+size_t SchedulingPolicy::GetSize() const{
+	return m_size;
+}
+
+
+void SchedulingPolicy::SetAgingStep(IScheduler::Clock::duration step){
+	m_agingStep.store( std::max<int64_t>(step.count(), 0) );
+}
+
+IScheduler::Clock::duration SchedulingPolicy::GetAgingStep() const{
+	return IScheduler::Clock::duration( m_agingStep.load() );
+}
+
+
+LatencyStats SchedulingPolicy::GetLatency(TaskPriority priority) const{
+	const LatencyCounter& counter = m_latency[priority];
+
+	LatencyStats stats;
+	stats.count	= counter.count.load(std::memory_order_relaxed);
+	stats.total	= IScheduler::Clock::duration( counter.total.load(std::memory_order_relaxed) );
+	stats.max	= IScheduler::Clock::duration( counter.max.load(std::memory_order_relaxed) );
+	return stats;
+}
+
+void SchedulingPolicy::ResetLatency(){
+	for(auto& counter : m_latency){
+		counter.count.store(0);
+		counter.total.store(0);
+		counter.max.store(0);
+	}
+}
+
+
+int64_t SchedulingPolicy::GetLevel(const ScheduledTask& entry, int64_t base, IScheduler::Clock::time_point now) const{
+	int64_t step = m_agingStep.load(std::memory_order_relaxed);
+	if(step == 0)
+		return base;
+	return base + (now - entry.queued).count() / step;
+}
+
+//      (HelpWait),     CAS
+void SchedulingPolicy::RecordDispatch(const ScheduledTask& entry){
+	LatencyCounter& counter = m_latency[entry.priority];
+	int64_t latency = (IScheduler::Clock::now() - entry.queued).count();
+
+	counter.count.fetch_add(1, std::memory_order_relaxed);
+	counter.total.fetch_add(latency, std::memory_order_relaxed);
+	int64_t max = counter.max.load(std::memory_order_relaxed);
+	while(latency > max && !counter.max.compare_exchange_weak(max, latency, std::memory_order_relaxed));
+}
+
+}
+}
\ No newline at end of file
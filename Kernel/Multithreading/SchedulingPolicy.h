@@ -0,0 +1,112 @@
+/****************************************************************************
+*	   - ThreadManager':					*
+*	   -    (EDF)   TP_MAXIMAL,		*
+*	 -     :  agingStep			*
+*	    ,   			*
+*	   ; Push/TryPop   -,	*
+*	      							*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ITask.h"
+#include "IScheduler.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+enum AffinityKind : uint8_t{
+	AK_NONE = 0,										//  
+	AK_SPAWNER,											// ,  ;   - 
+	AK_THREAD,											//   Thread::LocalID() == value
+	AK_WORKER,											//   value (   )
+	AK_KEY												//      value
+};
+
+//  :    ,    
+struct TaskAffinity{
+	AffinityKind					kind;
+	uint64_t						value;
+
+	static TaskAffinity Any()						{ return TaskAffinity{ AK_NONE, 0 }; }
+	static TaskAffinity Spawner()					{ return TaskAffinity{ AK_SPAWNER, 0 }; }
+	static TaskAffinity Worker(size_t index)		{ return TaskAffinity{ AK_WORKER, index }; }
+	static TaskAffinity Key(uint64_t key)			{ return TaskAffinity{ AK_KEY, key }; }
+	static TaskAffinity Key(const void* data)		{ return TaskAffinity{ AK_KEY, reinterpret_cast<uintptr_t>(data) }; }
+};
+
+struct ScheduledTask{
+	ITaskPtr						task;
+	TaskPriority					priority;			// ,     
+	IScheduler::Clock::time_point	queued;
+	IScheduler::Clock::time_point	deadline;			// NO_DEADLINE -  
+	TaskAffinity					affinity = TaskAffinity::Any();
+	uint32_t						generation = 0;		// task->GetGeneration()    
+
+//         (ChangeTaskPriority, RerunTask):    
+	bool IsSuperseded() const{
+		return generation != task->GetGeneration();
+	}
+
+	static constexpr IScheduler::Clock::time_point	NO_DEADLINE = IScheduler::Clock::time_point::max();
+};
+
+//           
+struct LatencyStats{
+	uint64_t						count;
+	IScheduler::Clock::duration		total;
+	IScheduler::Clock::duration		max;
+};
+
+
+class KERNEL_API SchedulingPolicy{
+private:
+	struct LatencyCounter{
+		std::atomic<uint64_t>		count;
+		std::atomic<int64_t>		total;				//   Clock
+		std::atomic<int64_t>		max;
+	};
+
+	struct LaterDeadline{
+		bool operator()(const ScheduledTask& lhs, const ScheduledTask& rhs) const{
+			return lhs.deadline > rhs.deadline;
+		}
+	};
+
+	SchedulingPolicy(const SchedulingPolicy&) = delete;
+	SchedulingPolicy& operator=(const SchedulingPolicy&) = delete;
+
+public:
+	SchedulingPolicy();
+
+	void					Push(ScheduledTask&& entry);
+	bool					TryPop(ScheduledTask& entry);			// false,   
+	void					RecordDispatch(const ScheduledTask& entry);	//    ;     
+	size_t					GetSize() const;
+
+	void					SetAgingStep(IScheduler::Clock::duration step);	// 0 -  :   
+	IScheduler::Clock::duration	GetAgingStep() const;
+
+	LatencyStats			GetLatency(TaskPriority priority) const;
+	void					ResetLatency();
+
+private:
+	int64_t					GetLevel(const ScheduledTask& entry, int64_t base, IScheduler::Clock::time_point now) const;
+
+private:
+	std::deque<ScheduledTask>	m_queues[TP_COUNT];					//   
+	std::vector<ScheduledTask>	m_deadlines;						//   
+	std::atomic<size_t>			m_size;
+	std::atomic<int64_t>		m_agingStep;						//   Clock
+	LatencyCounter				m_latency[TP_COUNT];
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+/********************************************************************
+*	 lock-free  ( , 		*
+*	)     ;		*
+*	     ,		*
+*	      ;			*
+*	    EpochManager			*
+********************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "EpochManager.h"
+#include "../Platform/Settings.h"
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+template <class T>
+class SegmentedQueue{
+private:
+	enum SlotState : uint8_t{
+		SS_EMPTY = 0,			//      
+		SS_FULL,				//    
+		SS_TAKEN				//   (    "" )
+	};
+
+	struct Slot{
+		Slot() : state(SS_EMPTY){}
+
+		std::atomic<uint8_t>	state;
+		T						data;
+	};
+
+	struct Segment{
+		Segment(uint32_t size) : enqueueIndx(0), dequeueIndx(0), next(nullptr){
+			slots = new Slot[size];
+		}
+		~Segment(){
+			delete[] slots;
+		}
+
+		std::atomic<uint32_t>	enqueueIndx;
+		uint8_t					pad0[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<uint32_t>)];
+		std::atomic<uint32_t>	dequeueIndx;
+		uint8_t					pad1[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<uint32_t>)];
+		std::atomic<Segment*>	next;
+		Slot*					slots;
+	};
+
+private:
+	SegmentedQueue(const SegmentedQueue&) = delete;
+	SegmentedQueue& operator=(const SegmentedQueue&) = delete;
+
+public:
+	explicit SegmentedQueue(uint32_t segmentSize = 256) : m_segmentSize(segmentSize){
+		Segment* seg = new Segment(m_segmentSize);
+		m_head.store(seg);
+		m_tail.store(seg);
+		m_size.store(0);
+	}
+
+	~SegmentedQueue(){
+		Segment* seg = m_head.load();
+		while(seg != nullptr){
+			Segment* next = seg->next.load();
+			delete seg;
+			seg = next;
+		}
+	}
+
+
+	void push(const T& val){
+		T tmp(val);
+		Push(tmp);
+	}
+
+	void push(T&& val){
+		T tmp(std::move(val));
+		Push(tmp);
+	}
+
+	bool try_pop(T* elem){
+		EpochGuard guard;
+
+		while(true){
+			Segment* head = m_head.load(std::memory_order_acquire);
+			if( head->dequeueIndx.load() >= head->enqueueIndx.load() && head->next.load() == nullptr )
+				return false;															//  
+
+			uint32_t indx = head->dequeueIndx.fetch_add(1);
+			if(indx >= m_segmentSize){
+				Segment* next = head->next.load(std::memory_order_acquire);
+				if(next == nullptr)
+					return false;
+
+			//      ,    
+				Segment* tail = head;
+				m_tail.compare_exchange_strong(tail, next);
+				if(m_head.compare_exchange_strong(head, next))
+					EpochManager::Instance().Retire(head);
+				continue;
+			}
+
+			Slot& slot = head->slots[indx];
+			if(slot.state.exchange(SS_TAKEN, std::memory_order_acq_rel) == SS_EMPTY)
+				continue;																//   ;   
+
+			*elem = std::move(slot.data);
+			m_size.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+
+//  :      
+	size_t size() const{
+		intptr_t size = m_size.load(std::memory_order_relaxed);
+		return size > 0 ? static_cast<size_t>(size) : 0;
+	}
+
+	bool empty() const{
+		EpochGuard guard;
+		Segment* head = m_head.load(std::memory_order_acquire);
+		return head->dequeueIndx.load() >= head->enqueueIndx.load() && head->next.load() == nullptr;
+	}
+
+private:
+	void Push(T& val){
+		EpochGuard guard;
+
+		while(true){
+			Segment* tail = m_tail.load(std::memory_order_acquire);
+			uint32_t indx = tail->enqueueIndx.fetch_add(1);
+
+			if(indx < m_segmentSize){
+				Slot& slot = tail->slots[indx];
+				slot.data = std::move(val);
+
+				uint8_t expected = SS_EMPTY;
+				if(slot.state.compare_exchange_strong(expected, SS_FULL, std::memory_order_acq_rel)){
+					m_size.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				val = std::move(slot.data);												//  "" ,   
+				continue;
+			}
+
+		//  :      
+			if(tail != m_tail.load())
+				continue;
+
+			Segment* next = tail->next.load(std::memory_order_acquire);
+			if(next == nullptr){
+				Segment* newSeg = new Segment(m_segmentSize);
+				newSeg->slots[0].data = std::move(val);
+				newSeg->slots[0].state.store(SS_FULL, std::memory_order_relaxed);
+				newSeg->enqueueIndx.store(1, std::memory_order_relaxed);
+
+				Segment* expected = nullptr;
+				if(tail->next.compare_exchange_strong(expected, newSeg)){
+					m_tail.compare_exchange_strong(tail, newSeg);
+					m_size.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				val = std::move(newSeg->slots[0].data);
+				delete newSeg;
+			}
+			else
+				m_tail.compare_exchange_strong(tail, next);
+		}
+	}
+
+private:
+	uint8_t						m_pad0[RGE_CACHE_LINE_SIZE];
+	std::atomic<Segment*>		m_head;
+	uint8_t						m_pad1[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<Segment*>)];
+	std::atomic<Segment*>		m_tail;
+	uint8_t						m_pad2[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<Segment*>)];
+	std::atomic<intptr_t>		m_size;
+	uint32_t					m_segmentSize;
+};
+
+}
+}
\ No newline at end of file
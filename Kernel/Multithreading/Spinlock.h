@@ -1,11 +1,14 @@
-/********************************************************
-*	-    		*
-********************************************************/
+/****************************************************************************
+*	-    :						*
+*	    ,   		*
+*	 std::atomic::wait; unlock     			*
+****************************************************************************/
 #pragma once
 
 #include "Multithreading.h"
+#include "Backoff.h"
 #include <atomic>
-#include <thread>
+#include <cstdint>
 
 
 namespace RGE
@@ -14,51 +17,60 @@ namespace Multithreading
 {
 
 class Spinlock{
+private:
+	enum LockState : uint32_t{
+		LS_UNLOCKED = 0,
+		LS_LOCKED,
+		LS_LOCKED_WITH_WAITERS						//   , unlock   
+	};
+
+	Spinlock(const Spinlock&) = delete;
+	Spinlock& operator=(const Spinlock&) = delete;
+
 public:
-	Spinlock(uint32_t sleepTime_ms = 0, uint32_t busyWaitTriesCount = 50){
-		m_locked.clear();
-		m_sleepTime			=	std::chrono::milliseconds(sleepTime_ms);
-		m_busyWaitTriesCount=	busyWaitTriesCount;
-	}
-	~Spinlock(){
-		m_locked.clear();
+	Spinlock(uint32_t maxPauseCount = 64) : m_maxPauseCount(maxPauseCount){
+		m_state.store(LS_UNLOCKED);
 	}
+	~Spinlock(){}
 
 	void lock(){
-		uint32_t tryCount = m_busyWaitTriesCount;
-		while(tryCount--) {
-			if(!m_locked.test_and_set())
-				return;
-		}
+		if(try_lock())
+			return;
 
-		while(true){
-			if(!m_locked.test_and_set())
+		Backoff backoff(m_maxPauseCount);
+		while(!backoff.IsSaturated()){
+			if(m_state.load(std::memory_order_relaxed) == LS_UNLOCKED && try_lock())
 				return;
-			std::this_thread::sleep_for(m_sleepTime);
+			backoff.Pause();
 		}
+
+	//        :      
+		while(m_state.exchange(LS_LOCKED_WITH_WAITERS, std::memory_order_acquire) != LS_UNLOCKED)
+			m_state.wait(LS_LOCKED_WITH_WAITERS, std::memory_order_relaxed);
 	}
 
 	bool try_lock(){
-		return m_locked.test_and_set();
+		uint32_t expected = LS_UNLOCKED;
+		return m_state.compare_exchange_strong(expected, LS_LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
 	}
 
 	void unlock(){
-		m_locked.clear();
+		if(m_state.exchange(LS_UNLOCKED, std::memory_order_release) == LS_LOCKED_WITH_WAITERS)
+			m_state.notify_one();
 	}
 
-
-	void set_sleep_time(uint32_t sleepTime_ms){
-		m_sleepTime = std::chrono::milliseconds(sleepTime_ms);
+	bool is_locked() const{
+		return m_state.load(std::memory_order_relaxed) != LS_UNLOCKED;
 	}
 
-	void set_busy_wait_tries_count(uint32_t busyWaitTriesCount) {
-		m_busyWaitTriesCount = busyWaitTriesCount;
+
+	void set_max_pause_count(uint32_t maxPauseCount){
+		m_maxPauseCount = maxPauseCount;
 	}
 
 private:
-	std::atomic_flag			m_locked;
-	std::chrono::milliseconds	m_sleepTime;
-	uint32_t					m_busyWaitTriesCount;
+	std::atomic<uint32_t>		m_state;
+	uint32_t					m_maxPauseCount;
 };
 
 }
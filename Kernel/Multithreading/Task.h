@@ -4,16 +4,30 @@
 *	   ,		*
 *	   ;	*
 *	   : T f();			*
+*	   , 		*
+*	   InplaceFunction;			*
+*	:  , 			*
+*	std::atomic::wait   ;		*
+*	     			*
+*	  ,   	*
 ************************************************/
 #pragma once
 
 #include "Multithreading.h"
 #include "ITask.h"
+#include "IScheduler.h"
+#include "InplaceFunction.h"
+#include "AtomicWait.h"
+#include "CompletionCounter.h"
+#include "Continuation.h"
+#include "FiberScheduler.h"
+#include "Telemetry.h"
+#include "../Exception/Exception.h"
 #include <atomic>
-#include <mutex>
-#include <condition_variable>
-#include <functional>
 #include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 
 namespace RGE
@@ -21,63 +35,48 @@ namespace RGE
 namespace Multithreading
 {
 
-template <typename T>
-class Task : public ITask{
+//======================================
+//   : ,
+// ,   
+//======================================
+class TaskBase : public ITask{
 private:
-	Task() = delete;
-	Task(const Task& t) = delete;
-	Task(Task&& t) = delete;
-
-	Task& operator=(const Task&) = delete;
+	TaskBase(const TaskBase&) = delete;
+	TaskBase& operator=(const TaskBase&) = delete;
 
 public:
-	Task(std::function<T()> f){
-		m_f = f;
+	TaskBase() : m_completion(nullptr){
 		m_state.store(TS_QUEUED);
+		m_priority.store(TP_NORMAL);
+		m_generation.store(0);
+		m_startTime.store(0);
 	}
-	~Task(){}
-
-//     
-	void Perform(){
-		TaskState expected = TS_QUEUED;
-		if(!m_state.compare_exchange_strong(expected, TS_PROCESSING))
-			return;
-
-		try{
-			m_result = m_f();
-		}
-		catch(...){
-			m_exception = std::current_exception();
-		}
-		
-		std::lock_guard<std::mutex> lock(m_mutex);
-		m_state.store(TS_READY);
-		m_cond.notify_all();
-	}	
 
-//   ;      - 
-	T GetResult() const{
-		Wait();
-
-		if(m_exception)
-			std::rethrow_exception(m_exception);
-		return m_result;
-	}	
-
-//     
+//     ;       
 	void Wait() const{
-		if(m_state >= TS_READY)	return;
+		TaskState state = m_state.load(std::memory_order_acquire);
+		if(state < TS_READY){
+			FiberScheduler* fibers = FiberScheduler::Current();
+			if(fibers != nullptr && fibers->IsInFiber()){
+				fibers->Await([this](Continuation* cont){ return m_continuations.TryAdd(cont); });
+				return;
+			}
+		}
 
-		std::unique_lock<std::mutex> lock(m_mutex);
-		m_cond.wait( lock, [&](){return m_state >= TS_READY;} );
+		while(state < TS_READY){
+			m_spin.Wait(m_state, state);
+			state = m_state.load(std::memory_order_acquire);
+		}
 	}
 
 	TaskState GetState() const{
 		return m_state;
 	}
-	
+
 	void SetState(TaskState state){
 		m_state = state;
+		if(state >= TS_READY)				//     
+			m_state.notify_all();
 	}
 
 	TaskPriority GetPriority() const{
@@ -88,16 +87,167 @@ public:
 		m_priority.store(priority);
 	}
 
-private:
-	std::function<T()>				m_f;	
+	uint32_t GetGeneration() const{
+		return m_generation.load(std::memory_order_acquire);
+	}
+
+//  ,    ,  
+	void NextGeneration(){
+		m_generation.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+//   ExecuteAt:         time
+	void SetStartTime(IScheduler::Clock::time_point time){
+		m_startTime.store(time.time_since_epoch().count(), std::memory_order_release);
+	}
+
+	bool IsDue() const{
+		int64_t start = m_startTime.load(std::memory_order_acquire);
+		return start == 0 || IScheduler::Clock::now().time_since_epoch().count() >= start;
+	}
+
+// ,       
+	void SetCompletionCounter(CompletionCounter* counter){
+		m_completion = counter;
+	}
+
+// false,     
+	bool TryDiscard(){
+		TaskState expected = TS_QUEUED;
+		if(!m_state.compare_exchange_strong(expected, TS_DISCARDED))
+			return false;
+
+		m_state.notify_all();
+		m_continuations.Close();
+		if(m_completion)	m_completion->Done();
+		return true;
+	}
+
+//  ,  TryDiscard,  GetResult  Exception::Cancelled;
+//   ,   ,       
+	bool TryCancel(){
+		TaskState expected = TS_QUEUED;
+		if(!m_state.compare_exchange_strong(expected, TS_PROCESSING))
+			return false;
+
+		CompletionCounter* completion = m_completion;
+		m_exception = std::make_exception_ptr( Exception::Cancelled("Task was cancelled", __FILE__, __LINE__) );
+		SetState(TS_DISCARDED);
+		m_continuations.Close();
+		if(completion)	completion->Done();
+		return true;
+	}
+
+// false,           
+	bool TryRequeue(){
+		TaskState state = m_state.load();
+		while(state >= TS_READY)
+			if(m_state.compare_exchange_weak(state, TS_QUEUED)){
+				NextGeneration();
+				m_continuations.Reset();
+				return true;
+			}
+		return false;
+	}
+
+// false,    :  
+	bool TryAddContinuation(Continuation* cont){
+		return m_continuations.TryAdd(cont);
+	}
 
+protected:
+// false,    ,   
+	bool TryStart(){
+		TaskState expected = TS_QUEUED;
+		if(!m_state.compare_exchange_strong(expected, TS_PROCESSING))
+			return false;
+
+		m_exception = nullptr;
+		return true;
+	}
+
+	void Finish(){
+		CompletionCounter* completion = m_completion;		//  SetState    
+		TaskRun::Finishing(this);
+		SetState(TS_READY);
+		m_continuations.Close();
+		if(completion)	completion->Done();
+	}
+
+	void RethrowIfFailed() const{
+		if(m_exception)
+			std::rethrow_exception(m_exception);
+	}
+
+protected:
 	std::atomic<TaskState>			m_state;
 	std::atomic<TaskPriority>		m_priority;
-	mutable std::mutex				m_mutex;
-	mutable std::condition_variable	m_cond;
-
+	std::atomic<uint32_t>			m_generation;
+	std::atomic<int64_t>			m_startTime;			//   IScheduler::Clock; 0 -   
 	std::exception_ptr				m_exception;
-	T								m_result;
+	CompletionCounter*				m_completion;
+	mutable ContinuationList		m_continuations;		//   ,  
+	mutable AdaptiveSpin			m_spin;					//      
+};
+
+
+template <typename T>
+class Task : public TaskBase{
+private:
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type	ResultStorage;
+
+	Task() = delete;
+	Task(const Task& t) = delete;
+	Task(Task&& t) = delete;
+
+	Task& operator=(const Task&) = delete;
+
+public:
+	template <typename F>
+	Task(F&& f) : m_f(std::forward<F>(f)), m_hasResult(false){}
+
+	~Task(){
+		DestroyResult();
+	}
+
+//     
+	void Perform(){
+		if(!TryStart())
+			return;
+
+		DestroyResult();							//    (RerunTask)
+		try{
+			new(&m_result) T(m_f());
+			m_hasResult = true;
+		}
+		catch(...){
+			m_exception = std::current_exception();
+		}
+
+		Finish();
+	}
+
+//   ;      - ; Exception::Cancelled,    
+	T GetResult() const{
+		Wait();
+		RethrowIfFailed();
+		if(!m_hasResult)
+			RGE_Throw(Exception::Cancelled, "Task was discarded");
+		return *reinterpret_cast<const T*>(&m_result);
+	}
+
+private:
+	void DestroyResult(){
+		if(m_hasResult){
+			reinterpret_cast<T*>(&m_result)->~T();
+			m_hasResult = false;
+		}
+	}
+
+private:
+	InplaceFunction<T()>			m_f;
+	ResultStorage					m_result;				//       
+	bool							m_hasResult;
 };
 
 
@@ -105,22 +255,19 @@ private:
 //     T&
 //======================================
 template<typename T>
-class Task<T&> : public ITask{
+class Task<T&> : public TaskBase{
 private:
-	Task(const Task& t){}
-	Task(Task&& t){}
+	Task(const Task& t) = delete;
+	Task(Task&& t) = delete;
 
 public:
-	Task(std::function<T&()> f){
-		m_f = f;
-		m_state.store(TS_QUEUED);
-	}
+	template <typename F>
+	Task(F&& f) : m_f(std::forward<F>(f)), m_result(nullptr){}
 	~Task(){}
 
 
 	void Perform(){
-		TaskState expected = TS_QUEUED;
-		if(!m_state.compare_exchange_strong(expected, TS_PROCESSING))
+		if(!TryStart())
 			return;
 
 		try{
@@ -130,50 +277,19 @@ public:
 			m_exception = std::current_exception();
 		}
 
-		m_state = TS_READY;
-		m_cond.notify_one();
-	}	
+		Finish();
+	}
 
 	T& GetResult() const{
 		Wait();
-
-		if(m_exception)
-			std::rethrow_exception(m_exception);
+		RethrowIfFailed();
+		if(m_result == nullptr)
+			RGE_Throw(Exception::Cancelled, "Task was discarded");
 		return *m_result;
-	}	
-
-	void Wait() const{
-		if(m_state >= TS_READY)	return;
-
-		std::unique_lock<std::mutex> lock(m_mutex);
-		m_cond.wait( lock, [&](){return m_state >= TS_READY;} );
-	}
-
-	TaskState GetState() const{
-		return m_state;
-	}
-	
-	void SetState(TaskState state){
-		m_state = state;
-	}
-
-	TaskPriority GetPriority() const{
-		return m_priority;
-	}
-
-	void SetPriority(TaskPriority priority){
-		m_priority.store(priority);
 	}
 
 private:
-	std::function<T&()>				m_f;	
-
-	std::atomic<TaskState>			m_state;
-	std::atomic<TaskPriority>		m_priority;
-	mutable std::mutex				m_mutex;
-	mutable std::condition_variable	m_cond;
-
-	std::exception_ptr				m_exception;
+	InplaceFunction<T&()>			m_f;
 	T*								m_result;
 };
 
@@ -182,22 +298,19 @@ private:
 //     void
 //======================================
 template<>
-class Task<void> : public ITask{
+class Task<void> : public TaskBase{
 private:
-	Task(const Task&){}
-	Task(Task&&){}
+	Task(const Task&) = delete;
+	Task(Task&&) = delete;
 
 public:
-	Task(std::function<void()> f){
-		m_f = f;
-		m_state = TS_QUEUED;
-	}
+	template <typename F>
+	Task(F&& f) : m_f(std::forward<F>(f)){}
 	~Task(){}
 
 
 	void Perform(){
-		TaskState expected = TS_QUEUED;
-		if(!m_state.compare_exchange_strong(expected, TS_PROCESSING))
+		if(!TryStart())
 			return;
 
 		try{
@@ -207,50 +320,19 @@ public:
 			m_exception = std::current_exception();
 		}
 
-		std::unique_lock<std::mutex> lock(m_mutex);
-		m_state = TS_READY;
-		m_cond.notify_one();
-	}	
+		Finish();
+	}
 
+// Exception::Cancelled,    
 	void GetResult() const{
 		Wait();
-
-		if(m_exception)
-			std::rethrow_exception(m_exception);
-	}	
-
-	void Wait() const{
-		if(m_state >= TS_READY)	return;
-
-		std::unique_lock<std::mutex> lock(m_mutex);
-		m_cond.wait( lock, [&](){return m_state >= TS_READY;} );
-	}
-
-	TaskState GetState() const{
-		return m_state;
-	}
-	
-	void SetState(TaskState state){
-		m_state = state;
-	}
-
-	TaskPriority GetPriority() const{
-		return m_priority;
-	}
-
-	void SetPriority(TaskPriority priority){
-		m_priority.store(priority);
+		RethrowIfFailed();
+		if(m_state.load(std::memory_order_acquire) == TS_DISCARDED)
+			RGE_Throw(Exception::Cancelled, "Task was discarded");
 	}
 
 private:
-	std::function<void()>			m_f;	
-
-	std::atomic<TaskState>			m_state;
-	std::atomic<TaskPriority>		m_priority;
-	mutable std::mutex				m_mutex;
-	mutable std::condition_variable	m_cond;
-
-	std::exception_ptr				m_exception;
+	InplaceFunction<void()>			m_f;
 };
 
 }
@@ -0,0 +1,100 @@
+/****************************************************************************
+*	   : co_await taskProxy, co_await multitask;	*
+*	 ,     , 			*
+*	      			*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Task.h"
+#include "Multitask.h"
+#include "Coroutine.h"
+#include <atomic>
+#include <coroutine>
+#include <memory>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+template <typename T>
+class TaskAwaiter : public ResumeContinuation{
+public:
+	TaskAwaiter(std::shared_ptr<Task<T>> task) : m_task(std::move(task)){}
+
+	bool await_ready() const{
+		return m_task->GetState() >= TS_READY;
+	}
+
+	template <class Promise>
+	bool await_suspend(std::coroutine_handle<Promise> handle){
+		Bind(handle);
+		return m_task->TryAddContinuation(this);		// false -   
+	}
+
+	decltype(auto) await_resume() const{
+		return m_task->GetResult();
+	}
+
+private:
+	std::shared_ptr<Task<T>>	m_task;
+};
+
+
+//  ,    
+template <typename T>
+class MultitaskAwaiter : public ResumeContinuation{
+private:
+	struct SubtaskContinuation : public Continuation{
+		SubtaskContinuation() : Continuation(&OnDone), owner(nullptr){}
+
+		static void OnDone(Continuation* cont){
+			static_cast<SubtaskContinuation*>(cont)->owner->Arrive();
+		}
+
+		MultitaskAwaiter*	owner;
+	};
+
+public:
+	MultitaskAwaiter(std::shared_ptr<Multitask<T>> multitask) : m_multitask(std::move(multitask)){}
+
+	bool await_ready() const{
+		return m_multitask->GetTaskState() >= TS_READY;
+	}
+
+	template <class Promise>
+	bool await_suspend(std::coroutine_handle<Promise> handle){
+		Bind(handle);
+
+		int count = m_multitask->GetTaskCount();
+		m_subtasks.resize(count);
+		m_remaining.store(count + 1);					// +1    ,   
+
+		for(int i=0; i<count; i++){
+			m_subtasks[i].owner = this;
+			if(!m_multitask->GetSubtask(i)->TryAddContinuation(&m_subtasks[i]))
+				m_remaining.fetch_sub(1);
+		}
+
+		return m_remaining.fetch_sub(1) != 1;
+	}
+
+	void await_resume() const{}
+
+private:
+	void Arrive(){
+		if(m_remaining.fetch_sub(1) == 1)
+			Resume(this);
+	}
+
+private:
+	std::shared_ptr<Multitask<T>>		m_multitask;
+	std::vector<SubtaskContinuation>	m_subtasks;
+	std::atomic<int>					m_remaining;
+};
+
+}
+}
\ No newline at end of file
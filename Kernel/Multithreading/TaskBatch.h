@@ -0,0 +1,134 @@
+/****************************************************************
+*	      ; 	*
+*	ThreadManager::ExecuteBatch:    		*
+*	 ,       		*
+*	    ;  			*
+*	    (aliasing shared_ptr)		*
+****************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Task.h"
+#include "IScheduler.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class TaskBatchBase{
+private:
+	TaskBatchBase(const TaskBatchBase&) = delete;
+	TaskBatchBase& operator=(const TaskBatchBase&) = delete;
+
+public:
+	TaskBatchBase(TaskPriority priority) : m_priority(priority), m_queued(IScheduler::Clock::now()){}
+	virtual ~TaskBatchBase(){}
+
+	virtual size_t		GetTaskCount() const = 0;
+	virtual ITaskPtr	GetTask(size_t indx) = 0;
+
+	TaskPriority GetPriority() const{
+		return m_priority;
+	}
+
+	IScheduler::Clock::time_point GetQueuedTime() const{
+		return m_queued;
+	}
+
+private:
+	TaskPriority					m_priority;
+	IScheduler::Clock::time_point	m_queued;
+};
+
+typedef std::shared_ptr<TaskBatchBase>	TaskBatchPtr;
+
+
+template <typename T>
+class TaskBatch : public TaskBatchBase, public std::enable_shared_from_this< TaskBatch<T> >{
+private:
+	typedef typename std::aligned_storage<sizeof(Task<T>), alignof(Task<T>)>::type	TaskStorage;
+
+public:
+//   T f(size_t indx)    ,     
+	template <typename F>
+	TaskBatch(F&& f, size_t count, TaskPriority priority) : TaskBatchBase(priority), m_indexed(std::forward<F>(f)){
+		Construct(count, [this](size_t indx){ return [this, indx]() -> T { return m_indexed(indx); }; });
+	}
+
+//    T f()    
+	template <typename F>
+	TaskBatch(std::span<F> functions, TaskPriority priority) : TaskBatchBase(priority){
+		Construct(functions.size(), [&functions](size_t indx) -> F& { return functions[indx]; });
+	}
+
+	~TaskBatch(){
+		Destroy(m_count);
+	}
+
+
+	size_t GetTaskCount() const{
+		return m_count;
+	}
+
+	ITaskPtr GetTask(size_t indx){
+		return GetSubtask(indx);
+	}
+
+	std::shared_ptr<Task<T>> GetSubtask(size_t indx){
+		return std::shared_ptr<Task<T>>(this->shared_from_this(), At(indx));
+	}
+
+	void Wait() const{
+		for(size_t i=0; i<m_count; i++)
+			At(i)->Wait();
+	}
+
+	TaskState GetTaskState() const{
+		TaskState state = TS_COUNT;
+		for(size_t i=0; i<m_count && state>TS_QUEUED; i++)
+			state = std::min(state, At(i)->GetState());
+		return state;
+	}
+
+private:
+	template <typename Make>
+	void Construct(size_t count, Make make){
+		m_storage	= new TaskStorage[count];
+		m_count		= 0;
+		try{
+			for(; m_count<count; m_count++)
+				new(&m_storage[m_count]) Task<T>(make(m_count));
+		}
+		catch(...){
+			Destroy(m_count);
+			throw;
+		}
+	}
+
+	void Destroy(size_t count){
+		for(size_t i=0; i<count; i++)
+			At(i)->~Task();
+		delete[] m_storage;
+		m_storage = nullptr;
+	}
+
+	Task<T>* At(size_t indx) const{
+		return std::launder(reinterpret_cast<Task<T>*>(&m_storage[indx]));
+	}
+
+private:
+	std::function<T(size_t)>	m_indexed;
+	TaskStorage*				m_storage;						//     
+	size_t						m_count;
+};
+
+}
+}
\ No newline at end of file
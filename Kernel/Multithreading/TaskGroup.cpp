@@ -0,0 +1,80 @@
+#include "TaskGroup.h"
+#include <algorithm>
+#include <mutex>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+//      :       
+TaskGroup::TaskGroup() : m_tasks(std::make_shared<TaskList>()){
+	std::shared_ptr<TaskList> tasks = m_tasks;
+	m_registration = m_source.GetToken().Register([tasks](){ CancelQueued(*tasks); });
+}
+
+TaskGroup::TaskGroup(const CancellationToken& parent) : m_source(parent), m_tasks(std::make_shared<TaskList>()){
+	std::shared_ptr<TaskList> tasks = m_tasks;
+	m_registration = m_source.GetToken().Register([tasks](){ CancelQueued(*tasks); });
+}
+
+TaskGroup::~TaskGroup(){
+	m_source.GetToken().Unregister(m_registration);
+}
+
+
+void TaskGroup::Cancel(){
+	m_source.Cancel();
+}
+
+bool TaskGroup::IsCancelled() const{
+	return m_source.IsCancelled();
+}
+
+CancellationToken TaskGroup::GetToken() const{
+	return m_source.GetToken();
+}
+
+
+void TaskGroup::Wait() const{
+	std::vector<std::shared_ptr<TaskBase>> tasks;
+	{
+		std::lock_guard<Spinlock> guard(m_tasks->lock);
+		tasks = m_tasks->tasks;
+	}
+
+	for(auto& task : tasks)
+		ThreadManager::Instance().HelpWait(*task);
+}
+
+
+// ,   ,  
+void TaskGroup::Track(const std::shared_ptr<TaskBase>& task){
+	{
+		std::lock_guard<Spinlock> guard(m_tasks->lock);
+		auto& tasks = m_tasks->tasks;
+		if(tasks.size() >= m_tasks->compactSize){
+			tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [](const std::shared_ptr<TaskBase>& t){ return t->GetState() >= TS_READY; }), tasks.end());
+			m_tasks->compactSize = std::max(MIN_COMPACT_SIZE, 2 * tasks.size());
+		}
+		tasks.push_back(task);
+	}
+
+	if(m_source.IsCancelled())
+		task->TryCancel();
+}
+
+void TaskGroup::CancelQueued(TaskList& list){
+	std::vector<std::shared_ptr<TaskBase>> tasks;
+	{
+		std::lock_guard<Spinlock> guard(list.lock);
+		tasks = list.tasks;
+	}
+
+	for(auto& task : tasks)
+		task->TryCancel();
+}
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/****************************************************************************
+*	    : Cancel    			*
+*	  ( GetResult  Exception::Cancelled), 			*
+*	      -   		*
+*	 const CancellationToken&; ,   		*
+*	,    ;  			*
+*	     						*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ThreadManager.h"
+#include "CancellationToken.h"
+#include "Spinlock.h"
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class KERNEL_API TaskGroup{
+private:
+	struct TaskList{
+		TaskList() : compactSize(MIN_COMPACT_SIZE){}
+
+		Spinlock								lock;
+		std::vector<std::shared_ptr<TaskBase>>	tasks;
+		size_t									compactSize;		//      
+	};
+
+	static constexpr size_t	MIN_COMPACT_SIZE = 64;
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+public:
+	TaskGroup();
+	explicit TaskGroup(const CancellationToken& parent);
+	~TaskGroup();													//   :    
+
+	template <typename T, typename F>
+	TaskProxy<T> Execute(F&& f, TaskPriority priority=TP_NORMAL){
+		CancellationToken token = m_source.GetToken();
+		TaskProxy<T> proxy = ThreadManager::Instance().Execute<T>(
+			[token, func = std::forward<F>(f)]() mutable -> T { return Invoke<T>(func, token); }, priority);
+
+		Track(proxy.m_task);
+		return proxy;
+	}
+
+	template <typename T>
+	MultitaskProxy<T> Execute(std::function<T(int rank, int size)> f, uint8_t numThreads, TaskPriority priority=TP_MAXIMAL){
+		CancellationToken token = m_source.GetToken();
+		MultitaskProxy<T> proxy = ThreadManager::Instance().Execute<T>(
+			std::function<T(int, int)>([token, f](int rank, int size) -> T {
+				token.ThrowIfCancelled();
+				return f(rank, size);
+			}), numThreads, priority);
+
+		for(int i=0; i<proxy.GetTaskCount(); i++)
+			Track(proxy.GetSubtask(i).m_task);
+		return proxy;
+	}
+
+	void				Cancel();
+	bool				IsCancelled() const;
+	CancellationToken	GetToken() const;							//      
+
+	void				Wait() const;								//    ,   (HelpWait);   
+
+private:
+	template <typename T, typename F>
+	static T Invoke(F& f, const CancellationToken& token){
+		token.ThrowIfCancelled();									//  ,     
+		if constexpr(std::is_invocable_v<F&, const CancellationToken&>)
+			return f(token);
+		else
+			return f();
+	}
+
+	void				Track(const std::shared_ptr<TaskBase>& task);
+	static void			CancelQueued(TaskList& list);
+
+private:
+	CancellationSource			m_source;
+	std::shared_ptr<TaskList>	m_tasks;
+	uint64_t					m_registration;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "TaskPool.h"
+#include <new>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+//   ;       "" 
+class TaskPool::Holder{
+public:
+	Holder();
+	~Holder();
+
+	TaskPool*	pool;
+};
+
+static thread_local TaskPool*	t_localPool = nullptr;		// nullptr,         
+
+
+TaskPool::Holder::Holder() : pool(new TaskPool()){
+	t_localPool = pool;
+}
+
+TaskPool::Holder::~Holder(){
+	t_localPool = nullptr;
+	pool->Orphan();
+}
+
+
+TaskPool::TaskPool(){
+	for(uint32_t i=0; i<SIZE_CLASS_COUNT; i++){
+		m_free[i]		= nullptr;
+		m_freeCount[i]	= 0;
+		m_remoteFree[i].store(nullptr);
+	}
+	m_refCount.store(1);
+	m_orphaned.store(false);
+}
+
+TaskPool::~TaskPool(){
+	for(uint32_t i=0; i<SIZE_CLASS_COUNT; i++){
+		DeleteList(m_free[i]);
+		DeleteList(m_remoteFree[i].exchange(nullptr));
+		m_free[i] = nullptr;
+	}
+}
+
+
+void* TaskPool::Allocate(size_t size){
+	uint32_t sizeClass = GetSizeClass(size);
+	if(sizeClass != LARGE_BLOCK)
+		return Local().AllocateBlock(sizeClass);
+
+	BlockHeader* block = static_cast<BlockHeader*>( ::operator new(HEADER_SIZE + size) );
+	block->owner	 = nullptr;
+	block->next		 = nullptr;
+	block->sizeClass = LARGE_BLOCK;
+	return reinterpret_cast<uint8_t*>(block) + HEADER_SIZE;
+}
+
+void TaskPool::Deallocate(void* ptr){
+	if(ptr == nullptr)	return;
+
+	BlockHeader* block = reinterpret_cast<BlockHeader*>( static_cast<uint8_t*>(ptr) - HEADER_SIZE );
+	TaskPool* owner = block->owner;
+
+	if(owner == nullptr)
+		::operator delete(block);
+	else if(owner == t_localPool)
+		owner->FreeLocal(block);
+	else
+		owner->FreeRemote(block);
+}
+
+
+TaskPool& TaskPool::Local(){
+	static thread_local Holder holder;
+	return *holder.pool;
+}
+
+
+void* TaskPool::AllocateBlock(uint32_t sizeClass){
+//    -    
+	if(m_free[sizeClass] == nullptr){
+		BlockHeader* remote = m_remoteFree[sizeClass].exchange(nullptr, std::memory_order_acquire);
+		m_free[sizeClass] = remote;
+		for(; remote != nullptr; remote = remote->next)
+			m_freeCount[sizeClass]++;
+	}
+
+	BlockHeader* block = m_free[sizeClass];
+	if(block != nullptr){
+		m_free[sizeClass] = block->next;
+		m_freeCount[sizeClass]--;
+	}
+	else{
+		block = static_cast<BlockHeader*>( ::operator new(HEADER_SIZE + GetBlockSize(sizeClass)) );
+		block->owner	 = this;
+		block->sizeClass = sizeClass;
+	}
+
+	m_refCount.fetch_add(1, std::memory_order_relaxed);
+	return reinterpret_cast<uint8_t*>(block) + HEADER_SIZE;
+}
+
+void TaskPool::FreeLocal(BlockHeader* block){
+	uint32_t sizeClass = block->sizeClass;
+	if(m_freeCount[sizeClass] < MAX_CACHED_BLOCKS){
+		block->next = m_free[sizeClass];
+		m_free[sizeClass] = block;
+		m_freeCount[sizeClass]++;
+	}
+	else
+		::operator delete(block);
+
+	Release();
+}
+
+void TaskPool::FreeRemote(BlockHeader* block){
+	if(m_orphaned.load(std::memory_order_acquire))
+		::operator delete(block);
+	else{
+		std::atomic<BlockHeader*>& list = m_remoteFree[block->sizeClass];
+		BlockHeader* top = list.load(std::memory_order_relaxed);
+		do{
+			block->next = top;
+		} while(!list.compare_exchange_weak(top, block, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	Release();
+}
+
+// ,    ,   
+void TaskPool::Orphan(){
+	m_orphaned.store(true);
+	for(uint32_t i=0; i<SIZE_CLASS_COUNT; i++){
+		DeleteList(m_free[i]);
+		DeleteList(m_remoteFree[i].exchange(nullptr));
+		m_free[i]		= nullptr;
+		m_freeCount[i]	= 0;
+	}
+
+	Release();
+}
+
+void TaskPool::Release(){
+	if(m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		delete this;
+}
+
+
+uint32_t TaskPool::GetSizeClass(size_t size){
+	size_t blockSize = MIN_BLOCK_SIZE;
+	for(uint32_t sizeClass=0; sizeClass<SIZE_CLASS_COUNT; sizeClass++, blockSize <<= 1)
+		if(size <= blockSize)
+			return sizeClass;
+	return LARGE_BLOCK;
+}
+
+size_t TaskPool::GetBlockSize(uint32_t sizeClass){
+	return size_t(MIN_BLOCK_SIZE) << sizeClass;
+}
+
+void TaskPool::DeleteList(BlockHeader* block){
+	while(block != nullptr){
+		BlockHeader* next = block->next;
+		::operator delete(block);
+		block = next;
+	}
+}
+
+}
+}
\ No newline at end of file
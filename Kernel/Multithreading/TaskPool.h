@@ -0,0 +1,105 @@
+/****************************************************************************
+*	   ;        	*
+*	; ,    ,   lock-free		*
+*	       ;				*
+*	   ,     ;		*
+*		MakeTask       			*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class KERNEL_API TaskPool{
+private:
+	static const uint32_t	SIZE_CLASS_COUNT	= 4;		// 64, 128, 256, 512 
+	static const uint32_t	MIN_BLOCK_SIZE		= 64;
+	static const uint32_t	MAX_CACHED_BLOCKS	= 256;		//        
+	static const uint32_t	LARGE_BLOCK			= SIZE_CLASS_COUNT;
+
+	struct BlockHeader{
+		TaskPool*		owner;								// nullptr -     
+		BlockHeader*	next;
+		uint32_t		sizeClass;
+	};
+
+	static const size_t		HEADER_SIZE = (sizeof(BlockHeader) + 15) & ~size_t(15);
+
+	class Holder;
+
+private:
+	TaskPool();
+	TaskPool(const TaskPool&) = delete;
+	TaskPool& operator=(const TaskPool&) = delete;
+
+public:
+	~TaskPool();
+
+	static void*	Allocate(size_t size);
+	static void		Deallocate(void* ptr);
+
+private:
+	static TaskPool&	Local();							//   
+
+	void*			AllocateBlock(uint32_t sizeClass);
+	void			FreeLocal(BlockHeader* block);
+	void			FreeRemote(BlockHeader* block);
+	void			Orphan();								// - 
+	void			Release();								//     
+
+	static uint32_t	GetSizeClass(size_t size);
+	static size_t	GetBlockSize(uint32_t sizeClass);
+	static void		DeleteList(BlockHeader* block);
+
+private:
+	BlockHeader*				m_free[SIZE_CLASS_COUNT];			//   
+	uint32_t					m_freeCount[SIZE_CLASS_COUNT];
+	std::atomic<BlockHeader*>	m_remoteFree[SIZE_CLASS_COUNT];		// ,   
+	std::atomic<uint32_t>		m_refCount;							//   +  -
+	std::atomic_bool			m_orphaned;
+};
+
+
+// STL-  TaskPool ( std::allocate_shared)
+template <class T>
+class TaskAllocator{
+public:
+	typedef T	value_type;
+
+	TaskAllocator(){}
+	template <class U>
+	TaskAllocator(const TaskAllocator<U>&){}
+
+	T* allocate(size_t n){
+		return static_cast<T*>( TaskPool::Allocate(n * sizeof(T)) );
+	}
+
+	void deallocate(T* ptr, size_t){
+		TaskPool::Deallocate(ptr);
+	}
+
+	template <class U>
+	bool operator==(const TaskAllocator<U>&) const{ return true; }
+	template <class U>
+	bool operator!=(const TaskAllocator<U>&) const{ return false; }
+};
+
+
+template <typename T, typename F>
+std::shared_ptr<Task<T>> MakeTask(F&& f){
+	return std::allocate_shared<Task<T>>( TaskAllocator<Task<T>>(), std::forward<F>(f) );
+}
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "Telemetry.h"
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+struct TaskRunRecord{
+	WorkerStats*					stats;
+	const ITask*					task;
+	TaskPriority					priority;
+	IScheduler::Clock::time_point	start;
+};
+
+static thread_local TaskRunRecord	s_run = { nullptr, nullptr, TP_NORMAL, IScheduler::Clock::time_point() };
+
+
+void TaskRun::Begin(WorkerStats& stats, const ITask* task, TaskPriority priority, IScheduler::Clock::time_point start){
+	s_run.stats		= &stats;
+	s_run.task		= task;
+	s_run.priority	= priority;
+	s_run.start		= start;
+}
+
+void TaskRun::Finishing(const ITask* task){
+	if(s_run.task != task || s_run.stats == nullptr)
+		return;
+	s_run.stats->TaskFinished(s_run.priority, IScheduler::Clock::now() - s_run.start);
+	s_run.task = nullptr;
+}
+
+void TaskRun::End(){
+	if(s_run.task != nullptr)
+		Finishing(s_run.task);
+	s_run.stats = nullptr;
+}
+
+
+SchedulerSnapshot SchedulerSnapshot::Since(const SchedulerSnapshot& previous) const{
+	SchedulerSnapshot delta(*this);
+	delta.period			= time - previous.time;
+	delta.balancingMoves	= balancingMoves - previous.balancingMoves;
+
+	for(auto& worker : delta.workers){
+		for(auto& old : previous.workers){
+			if(old.id != worker.id)
+				continue;
+
+			worker.tasksDone	-= old.tasksDone;
+			worker.stolen		-= old.stolen;
+			worker.migrated		-= old.migrated;
+			worker.idleTime		-= old.idleTime;
+			worker.parkTime		-= old.parkTime;
+			for(int p=0; p<TP_COUNT; p++){
+				worker.queueLatency[p].Subtract(old.queueLatency[p]);
+				worker.runTime[p].Subtract(old.runTime[p]);
+			}
+			break;
+		}
+	}
+
+	return delta;
+}
+
+
+void SchedulerSnapshot::Write(Logging::ILog& log) const{
+	using std::chrono::duration_cast;
+	using std::chrono::milliseconds;
+	static const char* priorityNames[TP_COUNT] = {"min", "normal", "max"};
+
+	log.Write("scheduler: period %lld ms, queued %llu/%llu/%llu, pending %llu, balancing moves %llu",
+			  static_cast<long long>( duration_cast<milliseconds>(period).count() ),
+			  static_cast<unsigned long long>(queueDepth[TP_MINIMAL]), static_cast<unsigned long long>(queueDepth[TP_NORMAL]),
+			  static_cast<unsigned long long>(queueDepth[TP_MAXIMAL]), static_cast<unsigned long long>(pendingTasks),
+			  static_cast<unsigned long long>(balancingMoves));
+
+	for(auto& worker : workers){
+		log.Write("  worker %u (cpu %d): queue %llu, done %llu, stolen %llu, migrated %llu, idle %lld ms, parked %lld ms",
+				  static_cast<unsigned>(worker.id), static_cast<int>(worker.cpu),
+				  static_cast<unsigned long long>(worker.queueDepth), static_cast<unsigned long long>(worker.tasksDone),
+				  static_cast<unsigned long long>(worker.stolen), static_cast<unsigned long long>(worker.migrated),
+				  static_cast<long long>( duration_cast<milliseconds>(worker.idleTime).count() ),
+				  static_cast<long long>( duration_cast<milliseconds>(worker.parkTime).count() ));
+
+		for(int p=0; p<TP_COUNT; p++){
+			const HistogramSnapshot& wait	= worker.queueLatency[p];
+			const HistogramSnapshot& run	= worker.runTime[p];
+			if(wait.count == 0)
+				continue;
+
+			log.Write("    %s: tasks %llu, wait us mean %llu p50 %llu p99 %llu max %llu, run us mean %llu p50 %llu p99 %llu max %llu",
+					  priorityNames[p], static_cast<unsigned long long>(wait.count),
+					  static_cast<unsigned long long>(wait.Mean()), static_cast<unsigned long long>(wait.Percentile(0.5)),
+					  static_cast<unsigned long long>(wait.Percentile(0.99)), static_cast<unsigned long long>(wait.max_us),
+					  static_cast<unsigned long long>(run.Mean()), static_cast<unsigned long long>(run.Percentile(0.5)),
+					  static_cast<unsigned long long>(run.Percentile(0.99)), static_cast<unsigned long long>(run.max_us));
+		}
+	}
+}
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+/****************************************************************************
+*	 :   (  		*
+*	 )    ;  lock-free:			*
+*	     ,    ;				*
+*	      (Since),  			*
+*	  ,    									*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ITask.h"
+#include "IScheduler.h"
+#include "../Logging/ILog.h"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+//  0 -  ,  i - [2^(i-1), 2^i) ,  -  
+struct HistogramSnapshot{
+	static const uint32_t	BUCKET_COUNT = 32;
+
+	uint64_t	buckets[BUCKET_COUNT];
+	uint64_t	count;
+	uint64_t	total_us;
+	uint64_t	max_us;
+
+//   ,     fraction   (  )
+	uint64_t Percentile(double fraction) const{
+		uint64_t rank = static_cast<uint64_t>(fraction * count);
+		uint64_t seen = 0;
+		for(uint32_t i=0; i<BUCKET_COUNT; i++){
+			seen += buckets[i];
+			if(seen > rank)
+				return (uint64_t(1) << i) < max_us ? (uint64_t(1) << i) : max_us;
+		}
+		return max_us;
+	}
+
+	uint64_t Mean() const{
+		return count != 0 ? total_us / count : 0;
+	}
+
+// max    ,   
+	void Subtract(const HistogramSnapshot& previous){
+		for(uint32_t i=0; i<BUCKET_COUNT; i++)
+			buckets[i] -= previous.buckets[i];
+		count		-= previous.count;
+		total_us	-= previous.total_us;
+	}
+};
+
+
+class LatencyHistogram{
+private:
+	LatencyHistogram(const LatencyHistogram&) = delete;
+	LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+public:
+	LatencyHistogram(){
+		Reset();
+	}
+
+	void Add(IScheduler::Clock::duration duration){
+		int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+		uint64_t value = us > 0 ? static_cast<uint64_t>(us) : 0;
+
+		uint32_t bucket = static_cast<uint32_t>( std::bit_width(value) );
+		if(bucket >= HistogramSnapshot::BUCKET_COUNT)
+			bucket = HistogramSnapshot::BUCKET_COUNT - 1;
+
+		m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		m_count.fetch_add(1, std::memory_order_relaxed);
+		m_total.fetch_add(value, std::memory_order_relaxed);
+
+		uint64_t max = m_max.load(std::memory_order_relaxed);
+		while(value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+	}
+
+	HistogramSnapshot Snapshot() const{
+		HistogramSnapshot snapshot;
+		for(uint32_t i=0; i<HistogramSnapshot::BUCKET_COUNT; i++)
+			snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+		snapshot.count		= m_count.load(std::memory_order_relaxed);
+		snapshot.total_us	= m_total.load(std::memory_order_relaxed);
+		snapshot.max_us		= m_max.load(std::memory_order_relaxed);
+		return snapshot;
+	}
+
+	void Reset(){
+		for(auto& bucket : m_buckets)
+			bucket.store(0);
+		m_count.store(0);
+		m_total.store(0);
+		m_max.store(0);
+	}
+
+private:
+	std::atomic<uint64_t>	m_buckets[HistogramSnapshot::BUCKET_COUNT];
+	std::atomic<uint64_t>	m_count;
+	std::atomic<uint64_t>	m_total;				// 
+	std::atomic<uint64_t>	m_max;
+};
+
+
+struct WorkerSnapshot{
+	uint16_t			id;
+	uint32_t			cpu;
+	size_t				queueDepth;
+	uint64_t			tasksDone;							//  runTime:   ,      
+	uint64_t			stolen;								//     
+	uint64_t			migrated;							//    
+	IScheduler::Clock::duration		idleTime;				//  
+	IScheduler::Clock::duration		parkTime;				//   Suspend
+	HistogramSnapshot	queueLatency[TP_COUNT];				//       
+	HistogramSnapshot	runTime[TP_COUNT];
+};
+
+
+//    
+class WorkerStats{
+private:
+	WorkerStats(const WorkerStats&) = delete;
+	WorkerStats& operator=(const WorkerStats&) = delete;
+
+public:
+	WorkerStats(){
+		m_tasksDone.store(0);
+		m_stolen.store(0);
+		m_migrated.store(0);
+		m_idleTime.store(0);
+		m_parkTime.store(0);
+	}
+
+	void TaskStarted(TaskPriority priority, IScheduler::Clock::duration waited){
+		m_queueLatency[priority].Add(waited);
+	}
+
+	void TaskFinished(TaskPriority priority, IScheduler::Clock::duration run){
+		m_runTime[priority].Add(run);
+		m_tasksDone.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void TaskStolen()										{ m_stolen.fetch_add(1, std::memory_order_relaxed); }
+	void TaskMigrated()										{ m_migrated.fetch_add(1, std::memory_order_relaxed); }
+	void Idle(IScheduler::Clock::duration time)				{ m_idleTime.fetch_add(time.count(), std::memory_order_relaxed); }
+	void Parked(IScheduler::Clock::duration time)			{ m_parkTime.fetch_add(time.count(), std::memory_order_relaxed); }
+
+// id, cpu     
+	void Snapshot(WorkerSnapshot& snapshot) const{
+		snapshot.tasksDone	= m_tasksDone.load(std::memory_order_relaxed);
+		snapshot.stolen		= m_stolen.load(std::memory_order_relaxed);
+		snapshot.migrated	= m_migrated.load(std::memory_order_relaxed);
+		snapshot.idleTime	= IScheduler::Clock::duration( m_idleTime.load(std::memory_order_relaxed) );
+		snapshot.parkTime	= IScheduler::Clock::duration( m_parkTime.load(std::memory_order_relaxed) );
+		for(int p=0; p<TP_COUNT; p++){
+			snapshot.queueLatency[p]	= m_queueLatency[p].Snapshot();
+			snapshot.runTime[p]			= m_runTime[p].Snapshot();
+		}
+	}
+
+private:
+	LatencyHistogram		m_queueLatency[TP_COUNT];
+	LatencyHistogram		m_runTime[TP_COUNT];
+	std::atomic<uint64_t>	m_tasksDone;
+	std::atomic<uint64_t>	m_stolen;
+	std::atomic<uint64_t>	m_migrated;
+	std::atomic<int64_t>	m_idleTime;					//   Clock
+	std::atomic<int64_t>	m_parkTime;
+};
+
+
+// ,    : TaskBase::Finish   
+//   ,   WaitAllTasksCompleted     tasksDone
+class KERNEL_API TaskRun{
+public:
+	static void		Begin(WorkerStats& stats, const ITask* task, TaskPriority priority, IScheduler::Clock::time_point start);
+	static void		Finishing(const ITask* task);		//      
+	static void		End();								//  ,    Finish (,   )
+};
+
+
+struct KERNEL_API SchedulerSnapshot{
+	IScheduler::Clock::time_point	time;
+	IScheduler::Clock::duration		period;					//    
+	size_t							queueDepth[TP_COUNT];	//   ThreadManager'
+	size_t							pendingTasks;			//  ,    
+	uint64_t						balancingMoves;
+	std::vector<WorkerSnapshot>		workers;
+
+//     previous   ;    id
+	SchedulerSnapshot	Since(const SchedulerSnapshot& previous) const;
+	void				Write(Logging::ILog& log) const;
+};
+
+}
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Thread.h"
+#include "EpochManager.h"
+#include "Topology.h"
 
 
 namespace RGE
@@ -7,14 +9,20 @@ namespace Multithreading
 {
 
 std::atomic<uint16_t>	Thread::m_totalThreadCount = 0;
+static thread_local Thread*	s_current = nullptr;
 
 Thread::Thread(){
 	m_enable.store(true);
 	m_active.store(true);
 	m_free.store(true);
-	m_thread = std::move( std::thread([this](){ThreadFunction();}) );
-
+	m_idleSince.store(IScheduler::Clock::now().time_since_epoch().count());
+	m_suspendedSince.store(m_idleSince.load());
+	m_cpu.store(Topology::INVALID_CPU);
+	m_fiberMode.store(false);
+	m_hasSuspendedFibers.store(false);
 	m_localID = m_totalThreadCount++;
+	m_context.reset( new WorkerContext(m_localID) );
+	m_thread = std::move( std::thread([this](){ThreadFunction();}) );
 }
 
 Thread::~Thread(){
@@ -23,23 +31,37 @@ Thread::~Thread(){
 
 
 void Thread::Perform(const ITaskPtr& task){
-	m_tasks.push_back(task);
-	std::lock_guard<std::mutex> lock(m_mutex);
-	m_cond.notify_one();
+	ScheduledTask entry;
+	entry.task		= task;
+	entry.priority	= task->GetPriority();
+	entry.queued	= IScheduler::Clock::now();
+	entry.deadline	= ScheduledTask::NO_DEADLINE;
+	entry.generation = task->GetGeneration();
+	Perform(entry);
 }
 
-std::shared_ptr<Task<void>> Thread::Execute(std::function<void()> f){
-	auto newTask = std::make_shared<Task<void>>(f);		//TODO:     
-
-	m_tasks.push_back( newTask );
-	std::lock_guard<std::mutex> lock(m_mutex);
-	m_cond.notify_one();
+void Thread::Perform(const ScheduledTask& entry){
+	m_tasks.push(entry);
+	m_event.NotifyAll();
+}
 
-	return newTask;
+void Thread::Perform(const ScheduledTask* entries, size_t count){
+	for(size_t i=0; i<count; i++)
+		m_tasks.push(entries[i]);
+	if(count != 0)
+		m_event.NotifyAll();
 }
 
 bool Thread::TryGetLastTask(ITaskPtr& task){
-	return m_tasks.try_get_and_pop_back(&task);
+	ScheduledTask entry;
+	if(!m_tasks.try_pop(&entry))
+		return false;
+	task = std::move(entry.task);
+	return true;
+}
+
+bool Thread::TryGetLastTask(ScheduledTask& entry){
+	return m_tasks.try_pop(&entry);
 }
 
 size_t Thread::GetTaskCount() const{
@@ -53,9 +75,7 @@ void Thread::Join(){
 	m_enable.store(false);
 	m_active.store(true);			//   ,       
 	try{
-		m_mutex.lock();
-		m_cond.notify_one();
-		m_mutex.unlock();
+		m_event.NotifyAll();
 		m_thread.join();
 		m_active.store(false);
 	}
@@ -70,9 +90,7 @@ void Thread::Detach(){
 	m_enable.store(false);
 	m_active.store(true);			//   ,       
 	try{
-		m_mutex.lock();
-		m_cond.notify_one();
-		m_mutex.unlock();
+		m_event.NotifyAll();
 		m_thread.detach();
 		m_active.store(false);
 	}
@@ -83,13 +101,13 @@ void Thread::Detach(){
 
 //       
 void Thread::Suspend(){
+	m_suspendedSince.store(IScheduler::Clock::now().time_since_epoch().count());
 	m_active.store(false);
 }
 
 void Thread::Resume(){
 	m_active.store(true);
-	std::lock_guard<std::mutex> lock(m_mutex);
-	m_cond.notify_one();
+	m_event.NotifyAll();
 }
 
 
@@ -97,6 +115,14 @@ bool Thread::IsFree() const{
 	return m_free;
 }
 
+IScheduler::Clock::time_point Thread::GetIdleSince() const{
+	return IScheduler::Clock::time_point( IScheduler::Clock::duration(m_idleSince.load()) );
+}
+
+IScheduler::Clock::time_point Thread::GetSuspendedSince() const{
+	return IScheduler::Clock::time_point( IScheduler::Clock::duration(m_suspendedSince.load()) );
+}
+
 bool Thread::IsActive() const{
 	return m_active;
 }
@@ -109,28 +135,132 @@ uint16_t Thread::LocalID() const{
 	return m_localID;
 }
 
+Thread* Thread::Current(){
+	return s_current;
+}
+
+
+bool Thread::SetAffinity(uint32_t cpu){
+	if(!IsAlive() || Topology::Instance().FindCpu(cpu) == nullptr)
+		return false;
+	if(!Topology::SetThreadAffinity(m_thread, cpu))
+		return false;
+
+	m_cpu.store(cpu);
+	return true;
+}
+
+uint32_t Thread::GetCpu() const{
+	return m_cpu;
+}
+
+
+void Thread::SetFiberMode(bool fibers){
+	m_fiberMode.store(fibers);
+}
+
+bool Thread::IsFiberMode() const{
+	return m_fiberMode;
+}
+
+
+WorkerContext& Thread::GetContext(){
+	return *m_context;
+}
+
+WorkerStats& Thread::GetStats(){
+	return m_stats;
+}
+
+WorkerSnapshot Thread::GetTelemetry() const{
+	WorkerSnapshot snapshot;
+	m_stats.Snapshot(snapshot);
+	snapshot.id			= m_localID;
+	snapshot.cpu		= m_cpu;
+	snapshot.queueDepth	= m_tasks.size();
+	return snapshot;
+}
+
 
+//        ,   
+//   ,    
 void Thread::ThreadFunction(){
-	ITaskPtr task;
+	ScheduledTask entry;
+
+	s_current = this;
 
-	while(m_enable){
+	while(m_enable || HasSuspendedFibers()){
+		EpochManager::Instance().Quiesce();				//    ,   
+		IScheduler::Clock::time_point idleStart = IScheduler::Clock::now();
+		m_idleSince.store(idleStart.time_since_epoch().count());	//  m_free:       
 		m_free.store(true);
 
-		std::unique_lock<std::mutex> lock(m_mutex);
-		m_cond.wait( lock, [&](){return !m_tasks.empty() && m_active || !m_enable;} );
-		lock.unlock();
+		if(m_enable)
+			m_event.Await( [&](){return (!m_tasks.empty() || HasReadyFibers()) && m_active || !m_enable;} );
+		else if(!HasReadyFibers() && m_tasks.empty())
+			std::this_thread::yield();
+		m_stats.Idle(IScheduler::Clock::now() - idleStart);
 
 		m_free.store(false);
-		while(m_enable && m_tasks.try_get_and_pop_front(&task)){
-			task->Perform();
+		RunReadyFibers();
+		while((m_enable || HasSuspendedFibers()) && m_tasks.try_pop(&entry)){
+			m_context->BeginTask(m_fibers ? m_fibers->GetScratchMark() : 0);
+			RunTask(entry);
+			EpochManager::Instance().Quiesce();			//  :     
+			RunReadyFibers();							// ,   
 
 			if(!m_active){
-				lock.lock();
-				m_cond.wait( lock, [&](){return m_active || !m_enable;} );
-				lock.unlock();
+				IScheduler::Clock::time_point parkStart = IScheduler::Clock::now();
+				m_event.Await( [&](){return m_active || !m_enable;} );
+				m_stats.Parked(IScheduler::Clock::now() - parkStart);
 			}
 		}
 	}
+
+	m_fibers.reset();
+	m_hasSuspendedFibers.store(false);
+}
+
+//         ;   (ChangeTaskPriority,
+// RerunTask)  ,    ,    
+void Thread::RunTask(const ScheduledTask& entry){
+	if(entry.IsSuperseded() || entry.task->GetState() != TS_QUEUED)
+		return;
+
+	IScheduler::Clock::time_point start = IScheduler::Clock::now();
+	m_stats.TaskStarted(entry.priority, start - entry.queued);
+	TaskRun::Begin(m_stats, entry.task.get(), entry.priority, start);
+
+	if(!m_fiberMode)
+		entry.task->Perform();
+	else{
+		if(!m_fibers)
+			m_fibers.reset( new FiberScheduler(m_event) );
+		m_fibers->Run(entry.task);
+		CountSuspendedFibers();
+	}
+
+	TaskRun::End();
+}
+
+bool Thread::HasReadyFibers() const{
+	return m_fibers && m_fibers->HasReady();
+}
+
+void Thread::RunReadyFibers(){
+	if(m_fibers){
+		m_fibers->RunReady();
+		CountSuspendedFibers();
+	}
+}
+
+// m_fibers    ,    
+void Thread::CountSuspendedFibers(){
+	m_hasSuspendedFibers.store(m_fibers && m_fibers->GetSuspendedCount() != 0);
+}
+
+bool Thread::HasSuspendedFibers() const{
+	return m_hasSuspendedFibers;
 }
 
 }
@@ -1,16 +1,22 @@
 /********************************************
-*	    	*
+*	    ;	*
+*	    EventCount;	*
+*	    	*
+*	   ,   	*
 ********************************************/
 #pragma once
 
 #include "Multithreading.h"
-#include "SafeContainer.h"
+#include "SegmentedQueue.h"
 #include "Task.h"
+#include "TaskPool.h"
+#include "EventCount.h"
+#include "FiberScheduler.h"
+#include "SchedulingPolicy.h"
+#include "Telemetry.h"
+#include "WorkerContext.h"
 #include <functional>
-#include <deque>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <memory>
 
@@ -22,7 +28,7 @@ namespace Multithreading
 
 class KERNEL_API Thread{
 private:
-	typedef SafeContainer< std::deque<ITaskPtr> >	TaskDeque;
+	typedef SegmentedQueue<ScheduledTask>			TaskQueue;
 
 private:
 	Thread(const Thread&) = delete;
@@ -35,34 +41,67 @@ public:
 	~Thread();
 
 	void							Perform(const ITaskPtr& task);		//      
-	std::shared_ptr<Task<void>>		Execute(std::function<void()> f);
-	bool							TryGetLastTask(ITaskPtr& task);		//     
+	void							Perform(const ScheduledTask& entry);	//  ,       
+	void							Perform(const ScheduledTask* entries, size_t count);	//  ,    
+	template <typename F>
+	std::shared_ptr<Task<void>>		Execute(F&& f){
+		auto newTask = MakeTask<void>(std::forward<F>(f));
+		Perform(newTask);
+		return newTask;
+	}
+	bool							TryGetLastTask(ITaskPtr& task);		//      ( )
+	bool							TryGetLastTask(ScheduledTask& entry);
 	size_t							GetTaskCount() const;			
 
 	void							Join();
 	void							Detach();
 	void							Suspend();							//         
 	void							Resume();
+	IScheduler::Clock::time_point	GetSuspendedSince() const;			//   Suspend
 
 	bool							IsFree() const;
+	IScheduler::Clock::time_point	GetIdleSince() const;				//     ;    IsFree()
+	bool							HasSuspendedFibers() const;			//   ;    
 	bool							IsActive() const;
 	bool							IsAlive() const;
 
 	uint16_t						LocalID() const;
+	static Thread*					Current();							//  Thread,  ; nullptr   
+
+	bool							SetAffinity(uint32_t cpu);			//     
+	uint32_t						GetCpu() const;						// Topology::INVALID_CPU,    
+
+	void							SetFiberMode(bool fibers);			//    ;   
+	bool							IsFiberMode() const;
+
+	WorkerContext&					GetContext();						// scratch-   ;   - WorkerContext::Current()
+	WorkerStats&					GetStats();
+	WorkerSnapshot					GetTelemetry() const;
 
 private:
 	void							ThreadFunction();
+	void							RunTask(const ScheduledTask& entry);
+	bool							HasReadyFibers() const;
+	void							RunReadyFibers();
+	void							CountSuspendedFibers();
 
 private:
-	TaskDeque						m_tasks;
+	TaskQueue						m_tasks;
 	std::thread						m_thread;
 
-	std::mutex						m_mutex;
-	std::condition_variable			m_cond;
+	EventCount						m_event;							//     , Resume  Join
 
 	std::atomic_bool				m_enable;
 	std::atomic_bool				m_active;
 	std::atomic_bool				m_free;	
+	std::atomic<IScheduler::Clock::rep>	m_idleSince;
+	std::atomic<IScheduler::Clock::rep>	m_suspendedSince;
+	std::atomic<uint32_t>			m_cpu;
+	std::atomic_bool				m_fiberMode;
+	std::atomic_bool				m_hasSuspendedFibers;
+	std::unique_ptr<FiberScheduler>	m_fibers;							//      
+	WorkerStats						m_stats;
+	std::unique_ptr<WorkerContext>	m_context;
 
 	uint16_t						m_localID;
 };
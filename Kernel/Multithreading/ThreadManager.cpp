@@ -1,7 +1,10 @@
 #include "ThreadManager.h"
+#include "Topology.h"
 #include "..\Memory\PoolAllocator.h"
 #include "..\Memory\Adapter.h"
 #include <algorithm>
+#include <mutex>
+#include <vector>
 
 
 namespace RGE
@@ -13,9 +16,10 @@ Memory::PoolAllocator<Thread>		g_threadPoolAllocator(10);
 
 
 ThreadManager::ThreadManager() : 
+	m_delays([this](std::vector<TimerPtr>& expired){ ReleaseTimers(expired); }),
+	m_sleepTime(20),
 	m_minWorkersCount(1),
-	m_maxTaskCount(5),
-	m_sleepTime(20)
+	m_maxTaskCount(5)
 {
 //HACK:      deadlock     Windows
 	Thread th;
@@ -24,21 +28,34 @@ ThreadManager::ThreadManager() :
 	uint8_t workersCount = std::max<int8_t>( std::thread::hardware_concurrency()-1, m_minWorkersCount );
 	m_maxThreadCount = 4 * workersCount;
 
-	m_workers.resize(workersCount);
-	for(auto& worker : m_workers.get_unsafe())
-		worker = Memory::CreateShared<Thread>(g_threadPoolAllocator);
+	m_fiberMode.store(false);
+	m_helpingWait.store(false);
+	m_surplusWorkers.store(0);
+	m_balancingMoves.store(0);
+	m_elastic.store(false);
+	m_scalingDue.store(false);
+	m_idleTimeout	= std::chrono::milliseconds(5000);
+	m_scaleUpDelay	= m_sleepTime;
+	for(uint8_t i=0; i<workersCount; i++)
+		m_workers.push_back( CreateWorker() );
 
 	m_makeBalancing.store(false);
 	m_masterIsFree.store(true);
-	m_masterTask = std::make_shared<Task<void>>( [this](){ MasterJob(); } );		//TODO:     
+	m_masterTask = MakeTask<void>( [this](){ MasterJob(); } );
 	m_masterTask->SetState(TS_READY);
 }
 
 ThreadManager::~ThreadManager(){
-	for(auto& condemned : m_condemnedThreads.get_unsafe())	condemned->Join();
-	for(auto& lentThread : m_lentThreads.get_unsafe())		lentThread->Join();
-	for(auto& worker : m_workers.get_unsafe())				worker->Join();
-	m_master.Join();
+	m_delays.Stop();
+
+	auto join = [](const ThreadPtr& th){ th->Join(); return true; };
+
+	m_master.Join();							//    ,    ;      
+	m_condemnedThreads.for_each(join);
+	m_spareThreads.for_each(join);
+	m_blockedThreads.for_each(join);
+	m_lentThreads.for_each(join);
+	m_workers.for_each(join);
 }
 
 
@@ -48,27 +65,84 @@ ThreadManager& ThreadManager::Instance(){
 }
 
 
-void ThreadManager::WaitAllTasksCompleted() const{
-	m_masterTask->Wait();
+void ThreadManager::Schedule(std::coroutine_handle<> handle, TaskPriority priority){
+	Execute<void>([handle](){ handle.resume(); }, priority);
+}
 
-	while(true){
-		ThreadPtr busyWorker = FindMostBusyWorker();
-		if(busyWorker->IsFree())
-			return;
+void ThreadManager::ScheduleAt(std::coroutine_handle<> handle, Clock::time_point time, TaskPriority priority){
+	ExecuteAt<void>([handle](){ handle.resume(); }, time, priority);
+}
 
-		while(!busyWorker->IsFree())
-			std::this_thread::sleep_for(m_sleepTime);
+
+void ThreadManager::WaitAllTasksCompleted(){
+	HelpWait(m_completion);
+}
+
+void ThreadManager::SetHelpingWait(bool helping){
+	m_helpingWait.store(helping);
+}
+
+bool ThreadManager::IsHelpingWait() const{
+	return m_helpingWait;
+}
+
+// ,  ,     : Perform      ;
+//       -    
+void ThreadManager::HelpWait(ITask& task){
+	if(m_helpingWait && !IsInFiber()){
+		if(task.GetState() == TS_QUEUED && task.IsDue())
+			task.Perform();
+		while(task.GetState() < TS_READY && TryHelp());
 	}
+	task.Wait();
+}
+
+void ThreadManager::HelpWait(const CompletionCounter& counter){
+	if(m_helpingWait && !IsInFiber())
+		while(!counter.IsCompleted() && TryHelp());
+	counter.Wait();
+}
+
+//       (  ),       
+bool ThreadManager::TryHelp(){
+	ScheduledTask entry;
+	for(int priority=TP_COUNT-1; priority>=0; priority--)
+		if(m_tasks[priority].try_pop(&entry)){
+			if(entry.IsSuperseded())
+				return true;
+			if(!entry.task->IsDue() || IsPinnedElsewhere(entry)){	//      :    
+				m_tasks[priority].push(entry);
+				continue;
+			}
+			m_policy.RecordDispatch(entry);
+			entry.task->Perform();
+			return true;
+		}
+
+	ThreadPtr busyWorker = FindMostBusyWorker();
+	if(busyWorker == nullptr || !busyWorker->TryGetLastTask(entry))
+		return false;
+
+	if(entry.IsSuperseded())
+		return true;
+	if(!entry.task->IsDue() || IsPinnedElsewhere(entry)){	//     
+		busyWorker->Perform(entry);
+		return false;
+	}
+	busyWorker->GetStats().TaskStolen();
+	entry.task->Perform();
+	return true;
 }
 
 bool ThreadManager::AreAllTasksCompleted() const{
-	return FindMostBusyWorker()->IsFree();
+	return m_completion.IsCompleted();
 }
 
 int ThreadManager::GetQueuedTaskCount() const{
 	return	m_tasks[TP_MINIMAL].size() + 
 			m_tasks[TP_NORMAL].size() +
-			m_tasks[TP_MAXIMAL].size();
+			m_tasks[TP_MAXIMAL].size() +
+			m_policy.GetSize();
 }
 
 
@@ -101,20 +175,24 @@ uint8_t ThreadManager::GetMaxTaskCount() const{
 }
 
 float ThreadManager::GetLoadPercent() const{
-	float load = 0.0f;
+	float  load	 = 0.0f;
+	size_t count = 0;
 	
-	m_workers.lock();
-	for(auto& worker : m_workers.get_unsafe())
+	m_workers.for_each([&](const ThreadPtr& worker){
 		load += worker->GetTaskCount();
-	m_workers.unlock();
+		count++;
+		return true;
+	});
 
-	load = load / (m_maxTaskCount*m_workers.size()) * 100.0f;
+	if(count == 0)
+		return 0.0f;
+	load = load / (m_maxTaskCount*count) * 100.0f;
 	return load;
 }
 
 
 uint8_t ThreadManager::GetThreadsCount() const{
-	return static_cast<uint8_t>( m_workers.size() + m_lentThreads.size() + 1 );
+	return static_cast<uint8_t>( m_workers.size() + m_lentThreads.size() + m_blockedThreads.size() + m_spareThreads.size() + 1 );
 }
 
 uint8_t ThreadManager::GetWorkersCount() const{
@@ -129,6 +207,23 @@ uint8_t ThreadManager::GetCondemnedThreadsCount() const{
 	return static_cast<uint8_t>( m_condemnedThreads.size() );
 }
 
+uint64_t ThreadManager::GetStatSlotTotal(size_t slot) const{
+	uint64_t total = 0;
+	auto add = [&](const ThreadPtr& th){ total += th->GetContext().GetStatSlot(slot); return true; };
+	m_workers.for_each(add);
+	m_blockedThreads.for_each(add);
+	m_spareThreads.for_each(add);
+	return total;
+}
+
+uint8_t ThreadManager::GetBlockedThreadsCount() const{
+	return static_cast<uint8_t>( m_blockedThreads.size() );
+}
+
+uint8_t ThreadManager::GetSpareThreadsCount() const{
+	return static_cast<uint8_t>( m_spareThreads.size() );
+}
+
 uint8_t ThreadManager::SetWorkersCount(uint8_t _count){
 	int16_t count = _count - GetWorkersCount();
 	
@@ -142,8 +237,8 @@ uint8_t ThreadManager::IncreaseWorkersCount(uint8_t _count){
 	ThreadPtr th;
 
 	for(uint8_t i=0; i<count; i++){
-		if(!m_condemnedThreads.try_get_and_pop_back(&th))
-			th = Memory::CreateShared<Thread>(g_threadPoolAllocator);
+		if(!m_condemnedThreads.pop_back(&th))
+			th = CreateWorker();
 		m_workers.push_back(th);
 	}
 
@@ -155,7 +250,8 @@ uint8_t ThreadManager::DecreaseWorkersCount(uint8_t _count){
 
 	for(uint8_t i=0; i<count; i++){
 		ThreadPtr th = ReleaseWorkerThread();
-		m_condemnedThreads.push_back(th);
+		if(th != nullptr)
+			m_condemnedThreads.push_back(th);
 	}
 
 	if(!m_tasks[TP_MAXIMAL].empty())
@@ -168,9 +264,9 @@ uint8_t ThreadManager::DecreaseWorkersCount(uint8_t _count){
 ThreadPtr ThreadManager::LendThread(bool createNew){
 	ThreadPtr thread;
 
-	if(!m_condemnedThreads.try_get_and_pop_back(&thread)){
+	if(!m_condemnedThreads.pop_back(&thread)){
 		if(createNew && GetThreadsCount() < m_maxThreadCount){
-			thread = Memory::CreateShared<Thread>(g_threadPoolAllocator);
+			thread = CreateWorker();
 		}
 		else if(GetWorkersCount() > m_minWorkersCount){
 			thread = ReleaseWorkerThread();
@@ -191,82 +287,359 @@ void ThreadManager::ReturnThread(ThreadPtr& th){
 } 
 
 
+//           ;     ,
+//     ;      GetThreadsCount,  -    
+ThreadPtr ThreadManager::EnterBlockingRegion(){
+	Thread* current = Thread::Current();
+	if(current == nullptr)
+		return ThreadPtr();
+
+	ThreadPtr blocked;
+	m_workers.for_each([&](const ThreadPtr& worker){
+		if(worker.get() == current)
+			blocked = worker;
+		return blocked == nullptr;
+	});
+	if(blocked == nullptr || !m_workers.try_erase(blocked))
+		return ThreadPtr();
+	m_blockedThreads.push_back(blocked);
+
+	ThreadPtr spare;
+	{
+		std::lock_guard<Spinlock> guard(m_spareLock);
+		if(m_spareThreads.pop_back(&spare))
+			spare->Resume();
+		else if(GetThreadsCount() < m_maxThreadCount){
+			if(!m_condemnedThreads.pop_back(&spare))
+				spare = CreateWorker();
+		}
+		if(spare != nullptr)
+			m_workers.push_back(spare);
+	}
+	if(spare == nullptr){
+		m_blockedThreads.try_erase(blocked);
+		m_workers.push_back(blocked);
+		return ThreadPtr();
+	}
+
+	GrabAllTasks(blocked);
+	LaunchMasterThread();
+	return blocked;
+}
+
+void ThreadManager::LeaveBlockingRegion(ThreadPtr& blocked){
+	if(blocked == nullptr)
+		return;
+
+	if(m_blockedThreads.try_erase(blocked)){
+		m_workers.push_back(blocked);
+		m_surplusWorkers.fetch_add(1);
+		LaunchMasterThread();
+	}
+	blocked.reset();
+}
+
 void ThreadManager::SetMakeBalancing(bool balancing){
 	m_makeBalancing.store(balancing);
 }
 
+//    :      
+void ThreadManager::SetFiberMode(bool fibers){
+	m_fiberMode.store(fibers);
+
+	auto apply = [fibers](const ThreadPtr& th){ th->SetFiberMode(fibers); return true; };
+	m_workers.for_each(apply);
+	m_lentThreads.for_each(apply);
+	m_condemnedThreads.for_each(apply);
+}
+
+bool ThreadManager::IsFiberMode() const{
+	return m_fiberMode;
+}
+
+
+void ThreadManager::SetElasticScaling(bool elastic){
+	m_elastic.store(elastic);
+	RestartScalingTimer();
+}
+
+bool ThreadManager::IsElasticScaling() const{
+	return m_elastic;
+}
+
+void ThreadManager::SetIdleTimeout(long milliseconds){
+	m_idleTimeout = std::chrono::milliseconds(milliseconds);
+	RestartScalingTimer();
+}
+
+void ThreadManager::SetScaleUpDelay(long milliseconds){
+	m_scaleUpDelay = std::chrono::milliseconds(milliseconds);
+}
+
+void ThreadManager::SetMinWorkersCount(uint8_t count){
+	m_minWorkersCount = std::max<uint8_t>(count, 1);
+	if(GetWorkersCount() < m_minWorkersCount)
+		IncreaseWorkersCount(m_minWorkersCount - GetWorkersCount());
+}
+
+uint8_t ThreadManager::GetMinWorkersCount() const{
+	return m_minWorkersCount;
+}
+
+
+void ThreadManager::SetAgingTime(long milliseconds){
+	m_policy.SetAgingStep( std::chrono::milliseconds(milliseconds) );
+}
+
+LatencyStats ThreadManager::GetLatency(TaskPriority priority) const{
+	return m_policy.GetLatency(priority);
+}
+
+void ThreadManager::ResetLatency(){
+	m_policy.ResetLatency();
+}
+
+SchedulerSnapshot ThreadManager::GetTelemetry() const{
+	SchedulerSnapshot snapshot;
+	snapshot.time			= Clock::now();
+	snapshot.period			= Clock::duration::zero();
+	snapshot.pendingTasks	= m_policy.GetSize();
+	snapshot.balancingMoves	= m_balancingMoves.load(std::memory_order_relaxed);
+	for(int p=0; p<TP_COUNT; p++)
+		snapshot.queueDepth[p] = m_tasks[p].size();
 
+	m_workers.for_each([&](const ThreadPtr& worker){
+		snapshot.workers.push_back( worker->GetTelemetry() );
+		return true;
+	});
+	return snapshot;
+}
+
+
+//     ,         
 ThreadPtr ThreadManager::FindMostFreeWorker() const{
-	if(m_workers.size()==1)		
-		return m_workers.front();
+	ThreadPtr mostFreeWorker;
+	m_workers.for_each([&](const ThreadPtr& worker){
+		if(mostFreeWorker == nullptr || mostFreeWorker->GetTaskCount() > worker->GetTaskCount() || !mostFreeWorker->IsFree() && worker->IsFree())
+			mostFreeWorker = worker;
+		return true;
+	});
+
+	return mostFreeWorker;
+}
+
+//       :      ;
+//       near,    
+ThreadPtr ThreadManager::FindMostFreeWorker(const ThreadPtr& near) const{
+	const Topology& topology = Topology::Instance();
+	uint32_t nearCpu = near->GetCpu();
 
-	m_workers.lock();
-	ThreadPtr mostFreeWorker = m_workers.get_unsafe().front();
-	for(auto& worker : m_workers.get_unsafe())
-		if(mostFreeWorker->GetTaskCount() > worker->GetTaskCount() || !mostFreeWorker->IsFree() && worker->IsFree())
+	ThreadPtr mostFreeWorker;
+	m_workers.for_each([&](const ThreadPtr& worker){
+		if(worker == near || topology.GetDistance(nearCpu, worker->GetCpu()) > CD_SAME_L3)
+			return true;
+		if(mostFreeWorker == nullptr || mostFreeWorker->GetTaskCount() > worker->GetTaskCount() || !mostFreeWorker->IsFree() && worker->IsFree())
 			mostFreeWorker = worker;
-	m_workers.unlock();
+		return true;
+	});
 
+	if(mostFreeWorker == nullptr || near->GetTaskCount() < mostFreeWorker->GetTaskCount() + 1)
+		return FindMostFreeWorker();
 	return mostFreeWorker;
 }
 
+//       :       
+ThreadPtr ThreadManager::FindWorkerFor(const ScheduledTask& entry) const{
+	ThreadPtr target = FindAffinityWorker(entry.affinity);
+	if(target == nullptr)
+		return FindMostFreeWorker();
+	if(target->GetTaskCount() < m_maxTaskCount)
+		return target;
+	return FindMostFreeWorker(target);
+}
+
+//         :     
+ThreadPtr ThreadManager::FindAffinityWorker(const TaskAffinity& affinity) const{
+	size_t count = m_workers.size();
+	if(affinity.kind == AK_NONE || count == 0)
+		return nullptr;
+
+	uint64_t index = affinity.value % count;
+	if(affinity.kind == AK_KEY)
+		index = ((affinity.value * 0x9E3779B97F4A7C15ull) >> 32) % count;		//  :    
+
+	ThreadPtr found;
+	m_workers.for_each([&](const ThreadPtr& worker){
+		bool match = affinity.kind == AK_THREAD ? worker->LocalID() == affinity.value : index-- == 0;
+		if(match)
+			found = worker;
+		return !match;
+	});
+
+	return found;
+}
+
+//      ,    
+bool ThreadManager::IsPinnedElsewhere(const ScheduledTask& entry) const{
+	if(entry.affinity.kind == AK_NONE)
+		return false;
+	ThreadPtr target = FindAffinityWorker(entry.affinity);
+	return target != nullptr && target.get() != Thread::Current();
+}
+
 ThreadPtr ThreadManager::FindMostBusyWorker() const{
-	if(m_workers.size()==1)		
-		return m_workers.front();
-
-	m_workers.lock();
-	ThreadPtr mostBusyWorker = *std::max_element(	m_workers.get_unsafe().begin(),
-													m_workers.get_unsafe().end(),
-													[&](const ThreadPtr& worker, const ThreadPtr& busyWorker){
-														return busyWorker->GetTaskCount() > worker->GetTaskCount();
-													}
-												 );
-	m_workers.unlock();
+	ThreadPtr mostBusyWorker;
+	m_workers.for_each([&](const ThreadPtr& worker){
+		if(mostBusyWorker == nullptr || worker->GetTaskCount() > mostBusyWorker->GetTaskCount())
+			mostBusyWorker = worker;
+		return true;
+	});
+
 	return mostBusyWorker;
 }
 
-bool ThreadManager::TryGetNextTask(ITaskPtr& task){
-	if(m_tasks[TP_MAXIMAL].try_get_and_pop_front(&task))	return true;
-	if(m_tasks[TP_NORMAL].try_get_and_pop_front(&task))		return true;
-	if(m_tasks[TP_MINIMAL].try_get_and_pop_front(&task))	return true;
+//   lock-free;           m_policy
+//     ,    
+bool ThreadManager::TryGetNextTask(ScheduledTask& entry){
+	for(auto& queue : m_tasks)
+		while(queue.try_pop(&entry))
+			if(!entry.IsSuperseded())
+				m_policy.Push(std::move(entry));
 
+	while(m_policy.TryPop(entry))
+		if(!entry.IsSuperseded())
+			return true;
 	return false;
 }
 
+// -  :      
+void ThreadManager::Enqueue(const ITaskPtr& task, TaskPriority priority, Clock::time_point deadline, const TaskAffinity& affinity){
+	ScheduledTask entry;
+	entry.task		= task;
+	entry.priority	= priority;
+	entry.queued	= Clock::now();
+	entry.deadline	= deadline;
+	entry.affinity	= affinity;
+	entry.generation = task->GetGeneration();
+	if(affinity.kind == AK_SPAWNER){
+		Thread* spawner = Thread::Current();
+		entry.affinity = spawner != nullptr ? TaskAffinity{ AK_THREAD, spawner->LocalID() } : TaskAffinity::Any();
+	}
+	m_tasks[priority].push(entry);
+}
+
+
+//     ,    
+void ThreadManager::ReleaseTimers(std::vector<TimerPtr>& expired){
+	for(auto& timer : expired){
+		const std::shared_ptr<TaskBase>& task = timer->task;
+		if(task == nullptr){
+			m_scalingDue.store(true);
+			continue;
+		}
+		if(timer->period > Clock::duration::zero()){
+			if(timer->firings > 1 && !task->TryRequeue())	//       
+				continue;
+			task->SetCompletionCounter(&m_completion);
+			m_completion.Add();
+		}
+		Enqueue(task, timer->priority);
+	}
+
+	if(!expired.empty())
+		LaunchMasterThread();
+}
+
+//       ,    SchedulingPolicy   MaxTaskCount:
+//     min(n, )   ,    
+void ThreadManager::DispatchBatch(const TaskBatchPtr& batch){
+	size_t count = batch->GetTaskCount();
 
+	std::vector<ScheduledTask> entries(count);
+	for(size_t i=0; i<count; i++){
+		entries[i].task		= batch->GetTask(i);
+		entries[i].priority	= batch->GetPriority();
+		entries[i].queued	= batch->GetQueuedTime();
+		entries[i].deadline	= ScheduledTask::NO_DEADLINE;
+		entries[i].generation = entries[i].task->GetGeneration();
+	}
+
+//    :        
+	std::vector< std::pair<size_t, ThreadPtr> > workers;
+	m_workers.for_each([&](const ThreadPtr& worker){
+		workers.emplace_back(worker->GetTaskCount(), worker);
+		return true;
+	});
+
+	if(workers.empty()){										//   -    
+		for(auto& entry : entries)
+			m_policy.Push(std::move(entry));
+		return;
+	}
+
+	size_t parts = std::min(count, workers.size());
+	std::partial_sort(workers.begin(), workers.begin() + parts, workers.end(),
+		[](const std::pair<size_t, ThreadPtr>& a, const std::pair<size_t, ThreadPtr>& b){ return a.first < b.first; });
+
+	for(size_t part=0; part<parts; part++){
+		size_t first	= part * count / parts;
+		size_t last		= (part + 1) * count / parts;
+		workers[part].second->Perform(entries.data() + first, last - first);
+		for(size_t i=first; i<last; i++)
+			m_policy.RecordDispatch(entries[i]);
+	}
+}
+
+//     : ,  ,     ,
+//    ; ,    (),  
 void ThreadManager::TaskAssignement(){
-	ThreadPtr freeWorker;
-	ITaskPtr  task;
+	ThreadPtr		freeWorker;
+	ScheduledTask	entry;
 
-	while(TryGetNextTask(task)){
-		freeWorker = FindMostFreeWorker();
+	m_hasNewTask.store(false);
 
-		while(freeWorker->GetTaskCount() >= m_maxTaskCount){
-			std::this_thread::sleep_for(m_sleepTime);
-			freeWorker = FindMostFreeWorker();
+	TaskBatchPtr batch;
+	while(m_batches.try_pop(&batch))
+		DispatchBatch(batch);
+
+	while(TryGetNextTask(entry)){
+		freeWorker = FindWorkerFor(entry);
+
+		while(freeWorker == nullptr || freeWorker->GetTaskCount() >= m_maxTaskCount){
+			if(m_backlogStart == Clock::time_point())
+				m_backlogStart = Clock::now();
+			if(!TryGrowWorkers())
+				std::this_thread::sleep_for(m_sleepTime);
+			freeWorker = FindWorkerFor(entry);
 		}
 
-		freeWorker->Perform(task);
-		m_hasNewTask.store(false);
+		freeWorker->Perform(entry);
+		m_policy.RecordDispatch(entry);
 	}
+
+	m_backlogStart = Clock::time_point();			//  
 }
 
 void ThreadManager::ThreadBalancing(){
-	ThreadPtr freeWorker, busyWorker;
-	ITaskPtr  task;
+	ThreadPtr		freeWorker, busyWorker;
+	ScheduledTask	entry;
 
-	if(m_workers.size() == 1)
+	if(m_workers.size() <= 1)
 		return;
 
 	busyWorker = FindMostBusyWorker();
-	while(busyWorker->GetTaskCount() > 0){
-		freeWorker = FindMostFreeWorker();
+	while(busyWorker != nullptr && busyWorker->GetTaskCount() > 0){
+		freeWorker = FindMostFreeWorker(busyWorker);
 
-		if(busyWorker->GetTaskCount() < freeWorker->GetTaskCount() + 1)
+		if(freeWorker == nullptr || busyWorker->GetTaskCount() < freeWorker->GetTaskCount() + 1)
 			std::this_thread::sleep_for(m_sleepTime);
 		else
-			if(busyWorker->TryGetLastTask(task))
-				freeWorker->Perform(task);
+			if(busyWorker->TryGetLastTask(entry)){
+				freeWorker->Perform(entry);
+				busyWorker->GetStats().TaskStolen();
+				freeWorker->GetStats().TaskMigrated();
+				m_balancingMoves.fetch_add(1, std::memory_order_relaxed);
+			}
 
 		if(m_hasNewTask) 
 			TaskAssignement();
@@ -275,9 +648,107 @@ void ThreadManager::ThreadBalancing(){
 	}
 }
 
+bool ThreadManager::TryGrowWorkers(){
+	if(!m_elastic || GetThreadsCount() >= m_maxThreadCount)
+		return false;
+
+	Clock::time_point now = Clock::now();
+	if(now - m_backlogStart < m_scaleUpDelay || now - m_lastScaleUp < m_scaleUpDelay)
+		return false;
+
+	if(IncreaseWorkersCount(1) == 0)
+		return false;
+	m_lastScaleUp = now;
+	return true;
+}
+
+//      ,        ;
+//      : Join     ,    .
+//    IsFree:        
+void ThreadManager::RetireIdleWorkers(){
+	Clock::time_point now = Clock::now();
+	if(!m_elastic || now - m_lastScaleUp < m_idleTimeout)
+		return;
+
+	std::vector<ThreadPtr> idle;
+	m_workers.for_each([&](const ThreadPtr& worker){
+		if(worker->GetTaskCount() == 0 && worker->IsFree() && !worker->HasSuspendedFibers() && now - worker->GetIdleSince() >= m_idleTimeout)
+			idle.push_back(worker);
+		return true;
+	});
+
+	for(auto& worker : idle){
+		if(GetWorkersCount() <= m_minWorkersCount)
+			break;
+		if(!m_workers.try_erase(worker))
+			continue;
+
+		GrabAllTasks(worker);
+		m_condemnedThreads.push_back(worker);
+	}
+}
+
+//    ReleaseTimers    ,    
+void ThreadManager::RestartScalingTimer(){
+	if(m_scalingTimer != nullptr){
+		m_delays.Cancel(*m_scalingTimer);
+		m_scalingTimer.reset();
+	}
+	if(!m_elastic)
+		return;
+
+	Clock::duration period = std::max<Clock::duration>(m_idleTimeout / 2, std::chrono::milliseconds(1));
+	m_scalingTimer = m_delays.Add(nullptr, Clock::now() + period, TP_NORMAL, period);
+}
+
+//    ,        ;
+// ,  ,    ;     .
+//     ,       ,
+//     -  ;   ,     
+void ThreadManager::ParkSurplusWorkers(){
+	bool parked = false;
+	while(m_surplusWorkers.load() > 0){
+		ThreadPtr worker;
+		m_workers.for_each([&](const ThreadPtr& th){
+			bool idle = th->GetTaskCount() == 0 && th->IsFree();
+			if(!th->HasSuspendedFibers() && (idle || !th->IsFiberMode()) && (worker == nullptr || worker->GetTaskCount() > th->GetTaskCount()))
+				worker = th;
+			return true;
+		});
+		if(worker == nullptr || !m_workers.try_erase(worker))
+			break;
+
+		GrabAllTasks(worker);
+		worker->Suspend();
+		m_spareThreads.push_back(worker);
+		m_surplusWorkers.fetch_sub(1);
+		parked = true;
+	}
+
+	if(parked)
+		LaunchMasterThread();							//       
+}
+
+//     :  m_condemnedThreads      
+void ThreadManager::RetireSpareThreads(){
+	Clock::time_point now = Clock::now();
+	std::vector<ThreadPtr> idle;
+	m_spareThreads.for_each([&](const ThreadPtr& th){
+		if(now - th->GetSuspendedSince() >= m_idleTimeout)
+			idle.push_back(th);
+		return true;
+	});
+
+	for(auto& th : idle)
+		if(m_spareThreads.try_erase(th)){
+			th->Resume();
+			m_condemnedThreads.push_back(th);
+		}
+}
+
 void ThreadManager::JoinCondemnedThreads(){
 	ThreadPtr th;
-	while(m_condemnedThreads.try_get_and_pop_front(&th))
+	while(m_condemnedThreads.pop_front(&th))
 		th->Join();
 }
 
@@ -287,12 +758,23 @@ void ThreadManager::MasterJob(){
 
 		TaskAssignement();
 		if(m_makeBalancing)		ThreadBalancing();
+		if(m_scalingDue.exchange(false))
+			RetireIdleWorkers();
+		if(m_surplusWorkers.load() > 0)
+			ParkSurplusWorkers();
+		if(!m_spareThreads.empty())
+			RetireSpareThreads();
 		JoinCondemnedThreads();
 	
 		m_masterIsFree.store(true);
 	}
 }
 
+bool ThreadManager::IsInFiber(){
+	FiberScheduler* fibers = FiberScheduler::Current();
+	return fibers != nullptr && fibers->IsInFiber();
+}
+
 void ThreadManager::LaunchMasterThread(){
 	m_hasNewTask.store(true);
 	if(m_masterIsFree){
@@ -302,17 +784,20 @@ void ThreadManager::LaunchMasterThread(){
 }
 
 
+//       ;   
 ThreadPtr ThreadManager::ReleaseWorkerThread(){
-	m_workers.lock();
-	auto freeWorker = std::max_element(	m_workers.get_unsafe().begin(),
-										m_workers.get_unsafe().end(),
-										[&](const ThreadPtr& freeWorker, const ThreadPtr& worker){
-											return freeWorker->GetTaskCount() > worker->GetTaskCount();
-										}
-									   );
-	ThreadPtr mostFreeWorker = *freeWorker;
-	m_workers.get_unsafe().erase(freeWorker);
-	m_workers.unlock();
+	ThreadPtr mostFreeWorker;
+	do{
+		mostFreeWorker.reset();
+		m_workers.for_each([&](const ThreadPtr& worker){
+			if(mostFreeWorker == nullptr || mostFreeWorker->GetTaskCount() > worker->GetTaskCount())
+				mostFreeWorker = worker;
+			return true;
+		});
+	} while(mostFreeWorker != nullptr && !m_workers.try_erase(mostFreeWorker));
+
+	if(mostFreeWorker == nullptr)
+		return mostFreeWorker;
 
 	GrabAllTasks(mostFreeWorker);
 
@@ -321,11 +806,39 @@ ThreadPtr ThreadManager::ReleaseWorkerThread(){
 
 void ThreadManager::GrabAllTasks(ThreadPtr& th){
 	th->Suspend();
-	ITaskPtr task;
-	while(th->TryGetLastTask(task))
-		m_tasks[TP_MAXIMAL].push_front(task);
+	ScheduledTask entry;
+	while(th->TryGetLastTask(entry)){
+		entry.priority = TP_MAXIMAL;						//   :   
+		m_tasks[TP_MAXIMAL].push(entry);
+		th->GetStats().TaskStolen();
+	}
 	th->Resume();
 }
 
+//       () ;
+//    ,   
+void ThreadManager::PlaceThread(const ThreadPtr& th) const{
+	const std::vector<uint32_t>& placement = Topology::Instance().GetPlacementOrder();
+
+	std::vector<uint32_t> used;
+	auto collect = [&](const ThreadPtr& worker){ used.push_back(worker->GetCpu()); return true; };
+	m_workers.for_each(collect);
+	m_lentThreads.for_each(collect);
+
+	for(size_t slot = 1; slot < placement.size(); slot++){
+		if(std::find(used.begin(), used.end(), placement[slot]) == used.end()){
+			th->SetAffinity(placement[slot]);
+			return;
+		}
+	}
+}
+
+ThreadPtr ThreadManager::CreateWorker() const{
+	ThreadPtr th = Memory::CreateShared<Thread>(g_threadPoolAllocator);
+	PlaceThread(th);
+	th->SetFiberMode(m_fiberMode);
+	return th;
+}
+
 }
 }
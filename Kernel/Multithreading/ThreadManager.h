@@ -1,6 +1,11 @@
 /************************************************************
 *				    ;				*
 *	       ;	*
+*	    (Spawn);				*
+*	    (ExecuteAfter/At/	*
+*	Every)     DelayQueue;				*
+*	  (ExecuteBatch)   ;	*
+*	       	*
 ************************************************************/
 #pragma once
 
@@ -8,7 +13,17 @@
 #include "Thread.h"
 #include "Task.h"
 #include "Multitask.h"
-#include <list>
+#include "TaskBatch.h"
+#include "TaskPool.h"
+#include "SegmentedQueue.h"
+#include "List.h"
+#include "CompletionCounter.h"
+#include "IScheduler.h"
+#include "Coroutine.h"
+#include "TaskAwaiter.h"
+#include "DelayQueue.h"
+#include "SchedulingPolicy.h"
+#include "Spinlock.h"
 #include <memory>
 
 
@@ -20,10 +35,10 @@ namespace Multithreading
 typedef std::pair< size_t, const char* >	ThreadID;
 
 
-class KERNEL_API ThreadManager{
+class KERNEL_API ThreadManager : public IScheduler{
 public:	
-	typedef SafeContainer< std::deque<ITaskPtr> >	TaskDeque;
-	typedef SafeContainer< std::list<ThreadPtr> >	ThreadList;
+	typedef SegmentedQueue<ScheduledTask>			TaskQueue;
+	typedef List<ThreadPtr>							ThreadList;
 
 private:
 	ThreadManager();
@@ -38,69 +53,177 @@ public:
 	static ThreadManager& Instance();
 
 
-	template <typename T>
-	TaskProxy<T> Execute(std::function<T()> f, TaskPriority priority=TP_NORMAL){
-		auto newTask = std::make_shared<Task<T>>(f);		//TODO:    .     ?
+//   T f();    ,      
+	template <typename T, typename F>
+	TaskProxy<T> Execute(F&& f, TaskPriority priority=TP_NORMAL){
+		return Execute<T>(std::forward<F>(f), ScheduledTask::NO_DEADLINE, priority);
+	}
+
+//        ,     -   
+	template <typename T, typename F>
+	TaskProxy<T> Execute(F&& f, Clock::time_point deadline, TaskPriority priority=TP_NORMAL){
+		return Execute<T>(std::forward<F>(f), deadline, TaskAffinity::Any(), priority);
+	}
+
+//     ,     (MaxTaskCount),  -  
+// ,     ; ,    (Spawner),     
+//     
+	template <typename T, typename F>
+	TaskProxy<T> Execute(F&& f, const TaskAffinity& affinity, TaskPriority priority=TP_NORMAL){
+		return Execute<T>(std::forward<F>(f), ScheduledTask::NO_DEADLINE, affinity, priority);
+	}
+
+	template <typename T, typename F>
+	TaskProxy<T> Execute(F&& f, Clock::time_point deadline, const TaskAffinity& affinity, TaskPriority priority){
+		auto newTask = MakeTask<T>(std::forward<F>(f));
 
 		newTask->SetPriority(priority);
-		m_tasks[priority].push_back(newTask);
+		newTask->SetCompletionCounter(&m_completion);
+		m_completion.Add();
+		Enqueue(newTask, priority, deadline, affinity);
 		LaunchMasterThread();
 		
 		return TaskProxy<T>(newTask);
 	}
 
+//       time;      DelayedTaskProxy::Cancel
+	template <typename T, typename F>
+	DelayedTaskProxy<T> ExecuteAt(F&& f, Clock::time_point time, TaskPriority priority=TP_NORMAL){
+		auto newTask = MakeTask<T>(std::forward<F>(f));
+
+		newTask->SetPriority(priority);
+		newTask->SetStartTime(time);
+		newTask->SetCompletionCounter(&m_completion);
+		m_completion.Add();
+		TimerPtr timer = m_delays.Add(newTask, time, priority);
+
+		return DelayedTaskProxy<T>(newTask, TimerHandle(timer, &m_delays));
+	}
+
+	template <typename T, typename F>
+	DelayedTaskProxy<T> ExecuteAfter(F&& f, Clock::duration delay, TaskPriority priority=TP_NORMAL){
+		return ExecuteAt<T>(std::forward<F>(f), Clock::now() + delay, priority);
+	}
+
+//   void f()     period (period > 0),   -  period;
+//      ,  ; WaitAllTasksCompleted    
+	template <typename F>
+	TimerHandle ExecuteEvery(F&& f, Clock::duration period, TaskPriority priority=TP_NORMAL){
+		auto newTask = MakeTask<void>(std::forward<F>(f));
+
+		newTask->SetPriority(priority);
+		TimerPtr timer = m_delays.Add(newTask, Clock::now() + period, priority, period);
+
+		return TimerHandle(timer, &m_delays);
+	}
+
+//     :      
 	template <typename T>
-	MultitaskProxy<T> Execute(std::function<T(int rank, int size)> f, uint8_t numThreads){
-		auto newTask = std::make_shared<Multitask<T>>(f, numThreads);		//TODO:    .     ?
+	MultitaskProxy<T> Execute(std::function<T(int rank, int size)> f, uint8_t numThreads, TaskPriority priority=TP_MAXIMAL){
+		auto newTask = std::make_shared<Multitask<T>>(std::move(f), numThreads);
+		m_completion.Add(newTask->GetTaskCount());
 		for(int i=0; i<newTask->GetTaskCount(); i++){
 			auto subtask = newTask->GetSubtask(i);
-			subtask->SetPriority(TP_MAXIMAL);
-			m_tasks[TP_MAXIMAL].push_back(subtask);
+			subtask->SetPriority(priority);
+			subtask->SetCompletionCounter(&m_completion);
+			Enqueue(subtask, priority);
 		}
 		LaunchMasterThread();
 
 		return MultitaskProxy<T>(newTask);
 	}
 	
+//   count   T f(size_t indx):   ,    ,
+//   ;     min(count, ) ,  SchedulingPolicy
+	template <typename T, typename F>
+	BatchProxy<T> ExecuteBatch(F&& f, size_t count, TaskPriority priority=TP_NORMAL){
+		return SubmitBatch( std::make_shared< TaskBatch<T> >(std::forward<F>(f), count, priority) );
+	}
+
+//       T f()
+	template <typename T, typename F>
+	BatchProxy<T> ExecuteBatch(std::span<F> functions, TaskPriority priority=TP_NORMAL){
+		return SubmitBatch( std::make_shared< TaskBatch<T> >(functions, priority) );
+	}
+	
 	template <typename T>
 	bool RerunTask(TaskProxy<T>& task){
-		if(task.GetState() <= TS_PROCESSING)	//    
+		if(!task.m_task->TryRequeue())			//    
 			return false;
 
-		task.SetState(TS_QUEUED);
-		m_tasks[task.GetPriority()].push_back(task.m_task);
+		task.m_task->SetCompletionCounter(&m_completion);
+		m_completion.Add();
+		Enqueue(task.m_task, task.GetPriority());
 		LaunchMasterThread();
 
 		return true;
 	}
 
+//     :    ;     
+	template <typename T>
+	size_t RerunTasks(TaskProxy<T>* tasks, size_t count){
+		size_t requeued = 0;
+		for(size_t i=0; i<count; i++){
+			if(!tasks[i].m_task->TryRequeue())
+				continue;
+			tasks[i].m_task->SetCompletionCounter(&m_completion);
+			m_completion.Add();
+			Enqueue(tasks[i].m_task, tasks[i].GetPriority());
+			requeued++;
+		}
+		if(requeued != 0)
+			LaunchMasterThread();
+
+		return requeued;
+	}
+
 	template <typename T>
 	bool ChangeTaskPriority(TaskProxy<T>& task, TaskPriority newPriority){
 		if(task.GetPriority() == newPriority)	return true;
 		if(task.GetState() != TS_QUEUED)		return false;	//      
+		if(!task.m_task->IsDue())				return false;	//      
 
-	//       ,      
-		if(!m_tasks[task.GetPriority()].try_erase(task.m_task))
-			return false;
-
+	//  lock-free    ,         ,
+	//          ;    , 
+	//   GetQueuedTaskCount,      -      MaxTaskCount
 		task.SetPriority(newPriority);
-		m_tasks[newPriority].push_back(task);
+		task.m_task->NextGeneration();
+		Enqueue(task.m_task, newPriority);
+		LaunchMasterThread();
+
+		return true;
 	}
 
+//            
+	template <typename T>
+	Coroutine<T> Spawn(Coroutine<T> co, TaskPriority priority=TP_NORMAL){
+		static_cast<PromiseBase*>(co.m_promise)->Start(this, priority, &m_completion);
+		return co;
+	}
+
+	void		Schedule(std::coroutine_handle<> handle, TaskPriority priority);
+	void		ScheduleAt(std::coroutine_handle<> handle, Clock::time_point time, TaskPriority priority);
+
 //    ,         
 	template <typename T>
 	bool DiscardTask(TaskProxy<T>& task){
-		if(task.GetState() != TS_QUEUED)	//   
-			return false;
-		task.SetState(TS_DISCARDED);
-		return true;
+		return task.m_task->TryDiscard();	// false -   
 	}
 
 
-	void		WaitAllTasksCompleted() const;
+	void		WaitAllTasksCompleted();					// ,     ,   Execute
 	bool		AreAllTasksCompleted() const;
 	int			GetQueuedTaskCount() const;
 
+//  : Wait   WaitAllTasksCompleted,    ,    
+//   (    ),        ;  
+// ,    ;      
+	void		SetHelpingWait(bool helping);
+	bool		IsHelpingWait() const;
+	void		HelpWait(ITask& task);							//       (ITask::IsDue)
+	void		HelpWait(const CompletionCounter& counter);
+	bool		TryHelp();									//    ; false -  
+
 	void		SetSleepTime(long milliseconds);
 	bool		SetMaxThreadCount(uint8_t maxThreadCount);	//    GetThreadsCount()  maxThreadCount,  false 
 	uint8_t		GetMaxThreadCount() const;
@@ -108,7 +231,7 @@ public:
 	uint8_t		GetMaxTaskCount() const;
 	float		GetLoadPercent() const;						//   
 
-	uint8_t		GetThreadsCount() const;					//      (workers + lentThreads + masterThread)
+	uint8_t		GetThreadsCount() const;					//      (workers + lentThreads + blockedThreads + spareThreads + masterThread)
 	uint8_t		GetWorkersCount() const;					
 	uint8_t		GetLentThreadsCount() const;
 	uint8_t		GetCondemnedThreadsCount() const;
@@ -119,34 +242,113 @@ public:
 	ThreadPtr	LendThread(bool createNew=false);			//      
 	void		ReturnThread(ThreadPtr& th);				//   
 
+//    BlockingRegion: ,  Enter,    ( 
+//    ),      ,  GetThreadsCount() < GetMaxThreadCount();
+// Leave    ,         (    -
+// );  ,  IdleTimeout,  ; nullptr -   
+	ThreadPtr	EnterBlockingRegion();
+	void		LeaveBlockingRegion(ThreadPtr& blocked);
+	uint8_t		GetBlockedThreadsCount() const;
+	uint8_t		GetSpareThreadsCount() const;
+
 	void		SetMakeBalancing(bool balancing);			//     
 
+//  :   ( GetMaxThreadCount),      ScaleUpDelay,
+//  ,    IdleTimeout (   IdleTimeout   )
+	void		SetElasticScaling(bool elastic);
+	bool		IsElasticScaling() const;
+	void		SetIdleTimeout(long milliseconds);
+	void		SetScaleUpDelay(long milliseconds);
+	void		SetMinWorkersCount(uint8_t count);			//    DecreaseWorkersCount   
+	uint8_t		GetMinWorkersCount() const;
+	void		SetFiberMode(bool fibers);					//     :      
+	bool		IsFiberMode() const;
+
+	void		SetAgingTime(long milliseconds);			// ,     ; 0 -  
+	LatencyStats GetLatency(TaskPriority priority) const;	//        
+	void		ResetLatency();
+
+	SchedulerSnapshot GetTelemetry() const;					//     ;   - SchedulerSnapshot::Since
+	uint64_t	GetStatSlotTotal(size_t slot) const;		//   WorkerContext  ,      
+
 private:
-	ThreadPtr	FindMostFreeWorker() const;					//     
-	ThreadPtr	FindMostBusyWorker() const;					//     
-	bool		TryGetNextTask(ITaskPtr& task);				//      
+	ThreadPtr	FindMostFreeWorker() const;					//     ; nullptr,   
+	ThreadPtr	FindMostFreeWorker(const ThreadPtr& near) const;	//  ,       near  L2/L3
+	ThreadPtr	FindWorkerFor(const ScheduledTask& entry) const;	//    TaskAffinity
+	ThreadPtr	FindAffinityWorker(const TaskAffinity& affinity) const;	// nullptr -      
+	bool		IsPinnedElsewhere(const ScheduledTask& entry) const;	//    ,    
+	ThreadPtr	FindMostBusyWorker() const;					//     ; nullptr,   
+	bool		TryGetNextTask(ScheduledTask& entry);		//     SchedulingPolicy
+	void		Enqueue(const ITaskPtr& task, TaskPriority priority, Clock::time_point deadline=ScheduledTask::NO_DEADLINE, const TaskAffinity& affinity=TaskAffinity::Any());
+	void		ReleaseTimers(std::vector<TimerPtr>& expired);	//   DelayQueue     
+	void		DispatchBatch(const TaskBatchPtr& batch);	//     
+
+	template <typename T>
+	BatchProxy<T> SubmitBatch(const std::shared_ptr<TaskBatch<T>>& batch){
+		size_t count = batch->GetTaskCount();
+		for(size_t i=0; i<count; i++){
+			auto task = batch->GetSubtask(i);
+			task->SetPriority(batch->GetPriority());
+			task->SetCompletionCounter(&m_completion);
+		}
+
+		if(count != 0){
+			m_completion.Add(count);
+			m_batches.push(batch);
+			LaunchMasterThread();
+		}
+		return BatchProxy<T>(batch);
+	}
 
 	void		TaskAssignement();							//    
 	void		ThreadBalancing();							//   
+	bool		TryGrowWorkers();							// false -    
+	void		RetireIdleWorkers();						//     m_scalingTimer
+	void		RestartScalingTimer();
+	void		ParkSurplusWorkers();						//      BlockingRegion
+	void		RetireSpareThreads();
 	void		JoinCondemnedThreads();
 	void		MasterJob();								//  -
 	void		LaunchMasterThread();
 
 	ThreadPtr	ReleaseWorkerThread();						//      
 	void		GrabAllTasks(ThreadPtr& th);				//        
+	void		PlaceThread(const ThreadPtr& th) const;		//        Topology::GetPlacementOrder
+	ThreadPtr	CreateWorker() const;						//  ,      
+	static bool	IsInFiber();								//    ,   
 
 private:
 	Thread						m_master;					// -
 	ThreadList					m_workers;					// -   
 	ThreadList					m_lentThreads;				// ,    .     
 	ThreadList					m_condemnedThreads;			// ,   
-	TaskDeque					m_tasks[TP_COUNT];			//    
+	ThreadList					m_blockedThreads;			//   BlockingRegion
+	ThreadList					m_spareThreads;				//  : ,  
+	Spinlock					m_spareLock;				//    EnterBlockingRegion:    
+	std::atomic<int>			m_surplusWorkers;			//     
+	TaskQueue					m_tasks[TP_COUNT];			//    ;     m_policy
+	SegmentedQueue<TaskBatchPtr>	m_batches;				//  ExecuteBatch
+	SchedulingPolicy			m_policy;					//    ( -)
+
+	CompletionCounter			m_completion;				//   
+	DelayQueue					m_delays;					//    ,  Delay
 
 	ITaskPtr					m_masterTask;
 	std::chrono::milliseconds	m_sleepTime;	
 	std::atomic_bool			m_masterIsFree;	
 	std::atomic_bool			m_hasNewTask;				//      
 	std::atomic_bool			m_makeBalancing;			//     	
+	std::atomic_bool			m_fiberMode;
+	std::atomic_bool			m_helpingWait;
+	std::atomic<uint64_t>		m_balancingMoves;			//   ThreadBalancing'
+
+	std::atomic_bool			m_elastic;
+	std::atomic_bool			m_scalingDue;				//    
+	TimerPtr					m_scalingTimer;				//   :  ,   
+	std::chrono::milliseconds	m_idleTimeout;
+	std::chrono::milliseconds	m_scaleUpDelay;
+	Clock::time_point			m_lastScaleUp;				//  -
+	Clock::time_point			m_backlogStart;				//        ;  -
 
 	uint8_t						m_minWorkersCount;
 	uint8_t						m_maxThreadCount;			
@@ -159,6 +361,7 @@ private:
 template <typename T>
 class TaskProxy{
 	friend class ThreadManager;
+	friend class TaskGroup;
 private:
 	TaskProxy(){}
 
@@ -180,11 +383,12 @@ public:
 	}
 
 	T GetResult() const{
+		Wait();
 		return m_task->GetResult();
 	}
 
 	void Wait() const{
-		m_task->Wait();
+		ThreadManager::Instance().HelpWait(*m_task);
 	}
 
 	TaskState GetState() const{
@@ -195,6 +399,10 @@ public:
 		return m_task->GetPriority();
 	}
 
+	TaskAwaiter<T> operator co_await() const{
+		return TaskAwaiter<T>(m_task);
+	}
+
 private:
 	void SetState(TaskState state){
 		m_task->SetState(state);
@@ -204,11 +412,28 @@ private:
 		m_task->SetPriority(priority);
 	}
 
-private:
+protected:
 	std::shared_ptr<Task<T>> m_task;
 };
 #pragma endregion
 
+#pragma region DelayedTaskProxy
+template <typename T>
+class DelayedTaskProxy : public TaskProxy<T>{
+public:
+	DelayedTaskProxy(std::shared_ptr<Task<T>> task, const TimerHandle& timer) : TaskProxy<T>(task), m_timer(timer){}
+
+// false -     ;   GetResult  Exception::Cancelled
+	bool Cancel(){
+		m_timer.Cancel();
+		return this->m_task->TryCancel();
+	}
+
+private:
+	TimerHandle		m_timer;
+};
+#pragma endregion
+
 #pragma region MultitaskProxy
 template <typename T>
 class MultitaskProxy{
@@ -218,7 +443,8 @@ public:
 	}
 
 	void Wait() const{
-		m_multitask->Wait();
+		for(int i=0; i<m_multitask->GetTaskCount(); i++)
+			ThreadManager::Instance().HelpWait(*m_multitask->GetSubtask(i));
 	}
 
 	TaskState GetTaskState() const{
@@ -233,10 +459,50 @@ public:
 		return TaskProxy<T>(m_multitask->GetSubtask(indx));
 	}
 
+	MultitaskAwaiter<T> operator co_await() const{
+		return MultitaskAwaiter<T>(m_multitask);
+	}
+
 private:
 	std::shared_ptr<Multitask<T>> m_multitask;
 };
 #pragma endregion
 
+#pragma region BatchProxy
+template <typename T>
+class BatchProxy{
+public:
+	BatchProxy(std::shared_ptr<TaskBatch<T>> batch){
+		m_batch = batch;
+	}
+
+	void Wait() const{
+		for(size_t i=0; i<m_batch->GetTaskCount(); i++)
+			ThreadManager::Instance().HelpWait(*m_batch->GetSubtask(i));
+	}
+
+	TaskState GetTaskState() const{
+		return m_batch->GetTaskState();
+	}
+
+	size_t GetTaskCount() const{
+		return m_batch->GetTaskCount();
+	}
+
+	TaskProxy<T> GetSubtask(size_t indx){
+		return TaskProxy<T>(m_batch->GetSubtask(indx));
+	}
+
+	T GetResult(size_t indx) const{
+		auto task = m_batch->GetSubtask(indx);
+		ThreadManager::Instance().HelpWait(*task);
+		return task->GetResult();
+	}
+
+private:
+	std::shared_ptr<TaskBatch<T>> m_batch;
+};
+#pragma endregion
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+/****************************************************************************
+*	  :     		*
+*	;      			*
+*	  ;     			*
+*	   ,   unlock   			*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "Backoff.h"
+#include "../Platform/Settings.h"
+#include <atomic>
+#include <cstdint>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+class TicketLock{
+private:
+	static const uint32_t	PAUSES_PER_WAITER = 32;
+	static const uint32_t	WAIT_SLOT_COUNT = 8;
+	static const uint32_t	MAX_SPIN_DISTANCE = 2;		//       
+
+	TicketLock(const TicketLock&) = delete;
+	TicketLock& operator=(const TicketLock&) = delete;
+
+public:
+	TicketLock(uint32_t spinCount = 64) : m_spinCount(spinCount){
+		m_nextTicket.store(0);
+		m_nowServing.store(0);
+		m_parked.store(0);
+		for(uint32_t i=0; i<WAIT_SLOT_COUNT; i++)
+			m_waitSlots[i].store(0);
+	}
+	~TicketLock(){}
+
+	void lock(){
+		const uint32_t ticket = m_nextTicket.fetch_add(1, std::memory_order_relaxed);
+
+		uint32_t spinCount = 0;
+		uint32_t serving;
+		while((serving = m_nowServing.load(std::memory_order_acquire)) != ticket){
+			if(ticket - serving <= MAX_SPIN_DISTANCE && spinCount++ < m_spinCount){
+				for(uint32_t i = (ticket - serving) * PAUSES_PER_WAITER; i>0; i--)
+					RGE_CPU_RELAX();
+				continue;
+			}
+
+		//      ,     
+			std::atomic<uint32_t>& slot = m_waitSlots[ticket % WAIT_SLOT_COUNT];
+			uint32_t generation = slot.load();
+			m_parked.fetch_add(1);
+			if(m_nowServing.load() != ticket)
+				slot.wait(generation);
+			m_parked.fetch_sub(1);
+		}
+	}
+
+	bool try_lock(){
+		uint32_t serving = m_nowServing.load(std::memory_order_acquire);
+		uint32_t expected = serving;
+		return m_nextTicket.compare_exchange_strong(expected, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	void unlock(){
+		const uint32_t next = m_nowServing.load(std::memory_order_relaxed) + 1;
+		m_nowServing.store(next);
+		if(m_parked.load() != 0){
+			std::atomic<uint32_t>& slot = m_waitSlots[next % WAIT_SLOT_COUNT];
+			slot.fetch_add(1);
+			slot.notify_all();
+		}
+	}
+
+	bool is_locked() const{
+		return m_nextTicket.load(std::memory_order_relaxed) != m_nowServing.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<uint32_t>		m_nextTicket;
+	uint8_t						m_pad0[RGE_CACHE_LINE_SIZE - sizeof(std::atomic<uint32_t>)];
+	std::atomic<uint32_t>		m_nowServing;
+	std::atomic<uint32_t>		m_parked;					//   
+	std::atomic<uint32_t>		m_waitSlots[WAIT_SLOT_COUNT];	//       
+	uint32_t					m_spinCount;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+TimerWheel::TimerWheel(IScheduler::Clock::time_point start, IScheduler::Clock::duration tick) :
+	m_start(start),
+	m_tick(tick),
+	m_current(0),
+	m_size(0)
+{
+	for(uint32_t level=0; level<LEVEL_COUNT; level++){
+		std::fill(m_slots[level], m_slots[level] + SLOT_COUNT, nullptr);
+		m_levelSize[level] = 0;
+	}
+}
+
+//    ,    :   
+TimerWheel::~TimerWheel(){
+	for(uint32_t level=0; level<LEVEL_COUNT; level++)
+		for(uint32_t slot=0; slot<SLOT_COUNT; slot++)
+			while(m_slots[level][slot] != nullptr){
+				Timer* timer = m_slots[level][slot];
+				Unlink(timer);
+				timer->self.reset();
+			}
+}
+
+
+void TimerWheel::Insert(const TimerPtr& timer){
+	timer->expiry	= std::max(TickOf(timer->time), m_current);
+	timer->self		= timer;
+	Link(timer.get());
+	m_size++;
+}
+
+bool TimerWheel::Remove(Timer& timer){
+	if(timer.self == nullptr)
+		return false;
+
+	Unlink(&timer);
+	m_size--;
+	TimerPtr keep = std::move(timer.self);		//       self
+	return true;
+}
+
+
+void TimerWheel::Advance(IScheduler::Clock::time_point now, std::vector<TimerPtr>& expired){
+	if(now < m_start)
+		return;
+	uint64_t nowTick = static_cast<uint64_t>( (now - m_start) / m_tick );
+
+	while(m_current <= nowTick){
+		if(m_size == 0){
+			m_current = nowTick + 1;
+			break;
+		}
+
+		if((m_current & SLOT_MASK) == 0)
+			for(uint32_t level=1; level<LEVEL_COUNT; level++){
+				Cascade(level);
+				if(((m_current >> (level * LEVEL_BITS)) & SLOT_MASK) != 0)
+					break;
+			}
+
+		Timer*& head = m_slots[0][m_current & SLOT_MASK];
+		while(head != nullptr){
+			Timer* timer = head;
+			Unlink(timer);
+			m_size--;
+			expired.push_back(std::move(timer->self));
+		}
+		m_current++;
+
+	//       -   
+		if(m_levelSize[0] == 0 && (m_current & SLOT_MASK) != 0)
+			m_current = std::min((m_current | SLOT_MASK) + 1, nowTick + 1);
+	}
+}
+
+IScheduler::Clock::time_point TimerWheel::GetNextCheckTime() const{
+	if(m_size == 0)
+		return IScheduler::Clock::time_point::max();
+	if((m_current & SLOT_MASK) == 0 && m_size != m_levelSize[0])
+		return TimeOf(m_current);
+
+	uint64_t boundary = (m_current | SLOT_MASK) + 1;
+	if(m_levelSize[0] != 0)
+		for(uint64_t tick=m_current; tick<boundary; tick++)
+			if(m_slots[0][tick & SLOT_MASK] != nullptr)
+				return TimeOf(tick);
+	return TimeOf(boundary);
+}
+
+
+size_t TimerWheel::GetSize() const{
+	return m_size;
+}
+
+bool TimerWheel::IsEmpty() const{
+	return m_size == 0;
+}
+
+
+uint64_t TimerWheel::TickOf(IScheduler::Clock::time_point time) const{
+	if(time <= m_start)
+		return 0;
+	if(time == IScheduler::Clock::time_point::max())
+		return UINT64_MAX;
+
+	IScheduler::Clock::duration offset = time - m_start;
+	return static_cast<uint64_t>( (offset + m_tick - IScheduler::Clock::duration(1)) / m_tick );
+}
+
+IScheduler::Clock::time_point TimerWheel::TimeOf(uint64_t tick) const{
+	return m_start + m_tick * static_cast<int64_t>(tick);
+}
+
+
+//      ;       
+//       
+void TimerWheel::Link(Timer* timer){
+	static const uint64_t MAX_DELTA = (uint64_t(1) << (LEVEL_COUNT * LEVEL_BITS)) - 1;
+
+	uint64_t delta = timer->expiry - m_current;
+	uint32_t level = 0;
+	while(level < LEVEL_COUNT - 1 && delta >= (uint64_t(1) << ((level + 1) * LEVEL_BITS)))
+		level++;
+
+	uint64_t place	= delta > MAX_DELTA ? m_current + MAX_DELTA : timer->expiry;
+	uint32_t slot	= static_cast<uint32_t>( (place >> (level * LEVEL_BITS)) & SLOT_MASK );
+
+	Timer*& head	= m_slots[level][slot];
+	timer->level	= static_cast<uint8_t>(level);
+	timer->slot		= static_cast<uint8_t>(slot);
+	timer->prev		= nullptr;
+	timer->next		= head;
+	if(head != nullptr)
+		head->prev = timer;
+	head = timer;
+	m_levelSize[level]++;
+}
+
+void TimerWheel::Unlink(Timer* timer){
+	if(timer->prev != nullptr)
+		timer->prev->next = timer->next;
+	else
+		m_slots[timer->level][timer->slot] = timer->next;
+	if(timer->next != nullptr)
+		timer->next->prev = timer->prev;
+
+	timer->prev = timer->next = nullptr;
+	m_levelSize[timer->level]--;
+}
+
+void TimerWheel::Cascade(uint32_t level){
+	uint32_t slot	= static_cast<uint32_t>( (m_current >> (level * LEVEL_BITS)) & SLOT_MASK );
+	Timer* timer	= m_slots[level][slot];
+	m_slots[level][slot] = nullptr;
+
+	while(timer != nullptr){
+		Timer* next = timer->next;
+		m_levelSize[level]--;
+		Link(timer);
+		timer = next;
+	}
+}
+
+}
+}
\ No newline at end of file
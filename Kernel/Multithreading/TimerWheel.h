@@ -0,0 +1,89 @@
+/****************************************************************************
+*	  : LEVEL_COUNT   SLOT_COUNT		*
+*	,   L  SLOT_COUNT^L ;  		*
+*	  - O(1) (  ),  		*
+*	   ,     ;				*
+*	      ;  			*
+*	 -    (DelayQueue)		*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "ITask.h"
+#include "IScheduler.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+struct Timer{
+	std::shared_ptr<TaskBase>		task;
+	TaskPriority					priority;
+	IScheduler::Clock::time_point	time;				//  
+	IScheduler::Clock::duration		period;				// 0 -  
+	uint64_t						firings;
+
+//  
+	uint64_t						expiry;				//  
+	Timer*							prev;
+	Timer*							next;
+	uint8_t							level;
+	uint8_t							slot;
+	std::shared_ptr<Timer>			self;				//   ,    ; nullptr -    
+};
+
+typedef std::shared_ptr<Timer>		TimerPtr;
+
+
+class KERNEL_API TimerWheel{
+public:
+	static const uint32_t	LEVEL_BITS	= 8;
+	static const uint32_t	SLOT_COUNT	= 1 << LEVEL_BITS;
+	static const uint32_t	LEVEL_COUNT	= 4;				//    1  -  49 ;    
+
+private:
+	static const uint64_t	SLOT_MASK	= SLOT_COUNT - 1;
+
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+public:
+	TimerWheel(IScheduler::Clock::time_point start, IScheduler::Clock::duration tick=std::chrono::milliseconds(1));
+	~TimerWheel();
+
+	void	Insert(const TimerPtr& timer);				//  timer->time
+	bool	Remove(Timer& timer);						// false -     (  )
+
+//   expired       now
+	void	Advance(IScheduler::Clock::time_point now, std::vector<TimerPtr>& expired);
+
+// ,     Advance:         
+	IScheduler::Clock::time_point	GetNextCheckTime() const;
+
+	size_t	GetSize() const;
+	bool	IsEmpty() const;
+
+private:
+	uint64_t						TickOf(IScheduler::Clock::time_point time) const;	//   
+	IScheduler::Clock::time_point	TimeOf(uint64_t tick) const;
+
+	void	Link(Timer* timer);
+	void	Unlink(Timer* timer);
+	void	Cascade(uint32_t level);					//    level,    m_current
+
+private:
+	IScheduler::Clock::time_point	m_start;
+	IScheduler::Clock::duration		m_tick;
+	uint64_t						m_current;			//   
+	Timer*							m_slots[LEVEL_COUNT][SLOT_COUNT];
+	size_t							m_levelSize[LEVEL_COUNT];
+	size_t							m_size;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "Topology.h"
+#include "../Exception/Exception.h"
+#include <algorithm>
+#include <set>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+Topology::Topology() : m_coreCount(0), m_packageCount(0), m_numaNodeCount(0){
+	if(!DetectPlatform() || m_cpus.empty())
+		MakeFlat( std::max(1u, std::thread::hardware_concurrency()) );
+	Finalize();
+}
+
+
+const Topology& Topology::Instance(){
+	static Topology topology;
+	return topology;
+}
+
+
+uint32_t Topology::GetLogicalCpuCount() const{
+	return static_cast<uint32_t>(m_cpus.size());
+}
+
+uint32_t Topology::GetCoreCount() const{
+	return m_coreCount;
+}
+
+uint32_t Topology::GetPackageCount() const{
+	return m_packageCount;
+}
+
+uint32_t Topology::GetNumaNodeCount() const{
+	return m_numaNodeCount;
+}
+
+
+const LogicalCpu& Topology::GetCpu(uint32_t indx) const{
+	RGE_Assert(indx < m_cpus.size(), Exception::WrongArgument, "Wrong cpu index");
+	return m_cpus[indx];
+}
+
+const LogicalCpu* Topology::FindCpu(uint32_t id) const{
+	auto it = std::lower_bound(m_cpus.begin(), m_cpus.end(), id, [](const LogicalCpu& cpu, uint32_t id){ return cpu.id < id; });
+	if(it == m_cpus.end() || it->id != id)
+		return nullptr;
+	return &*it;
+}
+
+CpuDistance Topology::GetDistance(uint32_t cpuA, uint32_t cpuB) const{
+	const LogicalCpu* a = FindCpu(cpuA);
+	const LogicalCpu* b = FindCpu(cpuB);
+	if(a == nullptr || b == nullptr)	return CD_REMOTE;
+
+	if(a == b)							return CD_SAME_CPU;
+	if(a->core == b->core)				return CD_SAME_CORE;
+	if(a->l2Domain == b->l2Domain)		return CD_SAME_L2;
+	if(a->l3Domain == b->l3Domain)		return CD_SAME_L3;
+	if(a->numaNode == b->numaNode)		return CD_SAME_NODE;
+	return CD_REMOTE;
+}
+
+
+const std::vector<uint32_t>& Topology::GetPlacementOrder() const{
+	return m_placement;
+}
+
+
+void Topology::MakeFlat(uint32_t count){
+	m_cpus.resize(count);
+	for(uint32_t i=0; i<count; i++){
+		LogicalCpu& cpu = m_cpus[i];
+		cpu.id		 = i;
+		cpu.core	 = i;
+		cpu.package	 = 0;
+		cpu.l2Domain = i;
+		cpu.l3Domain = 0;
+		cpu.numaNode = 0;
+		cpu.smtIndex = 0;
+	}
+}
+
+//  //,  SMT-   
+void Topology::Finalize(){
+	std::sort(m_cpus.begin(), m_cpus.end(), [](const LogicalCpu& a, const LogicalCpu& b){ return a.id < b.id; });
+
+	std::set<uint32_t> cores, packages, nodes;
+	std::vector<uint32_t> coreThreads;
+	for(auto& cpu : m_cpus){
+		cores.insert(cpu.core);
+		packages.insert(cpu.package);
+		nodes.insert(cpu.numaNode);
+
+		if(coreThreads.size() <= cpu.core)
+			coreThreads.resize(cpu.core + 1, 0);
+		cpu.smtIndex = coreThreads[cpu.core]++;
+	}
+	m_coreCount		= static_cast<uint32_t>(cores.size());
+	m_packageCount	= static_cast<uint32_t>(packages.size());
+	m_numaNodeCount	= static_cast<uint32_t>(nodes.size());
+
+	std::vector<const LogicalCpu*> order;
+	for(auto& cpu : m_cpus)
+		order.push_back(&cpu);
+	std::stable_sort(order.begin(), order.end(), [](const LogicalCpu* a, const LogicalCpu* b){
+		if(a->smtIndex != b->smtIndex)	return a->smtIndex < b->smtIndex;
+		if(a->numaNode != b->numaNode)	return a->numaNode < b->numaNode;
+		if(a->l3Domain != b->l3Domain)	return a->l3Domain < b->l3Domain;
+		return a->l2Domain < b->l2Domain;
+	});
+
+	m_placement.clear();
+	for(auto cpu : order)
+		m_placement.push_back(cpu->id);
+}
+
+
+#if !defined(RGE_WINDOWS) && !defined(RGE_LINUX)
+bool Topology::DetectPlatform(){
+	return false;
+}
+
+bool Topology::SetThreadAffinity(std::thread&, uint32_t){
+	return false;
+}
+#endif
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+/****************************************************************************
+*	 :  ,  (SMT-),			*
+*	  L2/L3, NUMA-;     			*
+*	 (Linux - sysfs, Windows - GetLogicalProcessorInformationEx);	*
+*	  ,     ;	*
+*	    -     	*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "../Platform/Settings.h"
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+//       ;  ,    
+enum CpuDistance{
+	CD_SAME_CPU = 0,
+	CD_SAME_CORE,					// SMT-
+	CD_SAME_L2,
+	CD_SAME_L3,
+	CD_SAME_NODE,					//  NUMA-
+	CD_REMOTE,
+	CD_COUNT
+};
+
+struct LogicalCpu{
+	uint32_t	id;					//    
+	uint32_t	core;				//    (   )
+	uint32_t	package;
+	uint32_t	l2Domain;			//  id ,     L2
+	uint32_t	l3Domain;
+	uint32_t	numaNode;
+	uint32_t	smtIndex;			// 0 -    
+};
+
+
+class KERNEL_API Topology{
+public:
+	static const uint32_t	INVALID_CPU = uint32_t(-1);
+
+private:
+	Topology();
+	Topology(const Topology&) = delete;
+	Topology& operator=(const Topology&) = delete;
+
+public:
+	static const Topology&	Instance();
+
+	uint32_t				GetLogicalCpuCount() const;
+	uint32_t				GetCoreCount() const;
+	uint32_t				GetPackageCount() const;
+	uint32_t				GetNumaNodeCount() const;
+
+	const LogicalCpu&		GetCpu(uint32_t indx) const;
+	const LogicalCpu*		FindCpu(uint32_t id) const;		// nullptr,    
+	CpuDistance				GetDistance(uint32_t cpuA, uint32_t cpuB) const;
+
+//    :       (   L3 ),
+//  SMT-;         ,   
+	const std::vector<uint32_t>&	GetPlacementOrder() const;
+
+	static bool				SetThreadAffinity(std::thread& thread, uint32_t cpu);
+
+private:
+	bool					DetectPlatform();				//   Platform/<>/Topology_<>Impl.cpp
+	void					MakeFlat(uint32_t count);
+	void					Finalize();
+
+private:
+	std::vector<LogicalCpu>		m_cpus;						//   id
+	std::vector<uint32_t>		m_placement;
+	uint32_t					m_coreCount;
+	uint32_t					m_packageCount;
+	uint32_t					m_numaNodeCount;
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "WorkerContext.h"
+#include "Thread.h"
+#include "FiberScheduler.h"
+#include "../Memory/Align.h"
+#include "../Exception/Exception.h"
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+std::atomic<uint32_t>	WorkerContext::s_scratchSize	= 256 * 1024;
+std::atomic<uint8_t>	WorkerContext::s_resetMode		= SR_TASK;
+std::atomic<uint32_t>	WorkerContext::s_frame			= 0;
+
+
+WorkerContext::WorkerContext(uint16_t workerID) :
+	m_scratch(s_scratchSize.load()),
+	m_workerID(workerID),
+	m_frame(s_frame.load())
+{
+	for(auto& slot : m_statSlots)
+		slot.store(0, std::memory_order_relaxed);
+}
+
+WorkerContext::~WorkerContext(){}
+
+
+WorkerContext* WorkerContext::Current(){
+	Thread* thread = Thread::Current();
+	return thread != nullptr ? &thread->GetContext() : nullptr;
+}
+
+
+void WorkerContext::SetScratchSize(uint32_t bytes){
+	s_scratchSize.store(bytes);
+}
+
+uint32_t WorkerContext::GetScratchSize(){
+	return s_scratchSize;
+}
+
+//    :     
+void WorkerContext::SetResetMode(ScratchReset mode){
+	s_resetMode.store(mode);
+	NextFrame();
+}
+
+ScratchReset WorkerContext::GetResetMode(){
+	return static_cast<ScratchReset>( s_resetMode.load() );
+}
+
+void WorkerContext::NextFrame(){
+	s_frame.fetch_add(1);
+}
+
+
+uint16_t WorkerContext::GetWorkerID() const{
+	return m_workerID;
+}
+
+void* WorkerContext::Allocate(uint32_t size, uint32_t alignment){
+	return m_scratch.Allocate_unsafe(size, Memory::Align(alignment));
+}
+
+Memory::LinearAllocator& WorkerContext::GetScratch(){
+	return m_scratch;
+}
+
+void WorkerContext::ResetScratch(){
+	FiberScheduler* fibers = FiberScheduler::Current();
+	RollbackScratch(fibers != nullptr ? fibers->GetScratchMark() : 0);
+}
+
+
+void WorkerContext::AddToStatSlot(size_t slot, uint64_t value){
+	RGE_Assert(slot < STAT_SLOT_COUNT, Exception::WrongArgument, "Stat slot doesn't exist");
+	m_statSlots[slot].store(m_statSlots[slot].load(std::memory_order_relaxed) + value, std::memory_order_relaxed);	//   
+}
+
+uint64_t WorkerContext::GetStatSlot(size_t slot) const{
+	RGE_Assert(slot < STAT_SLOT_COUNT, Exception::WrongArgument, "Stat slot doesn't exist");
+	return m_statSlots[slot].load(std::memory_order_relaxed);
+}
+
+
+void WorkerContext::BeginTask(uint32_t fiberMark){
+	uint32_t frame = s_frame.load(std::memory_order_relaxed);
+	if(GetResetMode() == SR_TASK || frame != m_frame){
+		RollbackScratch(fiberMark);
+		m_frame = frame;
+	}
+}
+
+//     ,   LinearAllocator  
+void WorkerContext::RollbackScratch(uint32_t fiberMark){
+	if(fiberMark == 0)
+		m_scratch.Clear_unsafe();
+	else if(fiberMark < m_scratch.GetUsedMemorySize_unsafe())
+		m_scratch.Rollback_unsafe(fiberMark);
+}
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+/****************************************************************************
+*	  ,     :		*
+*	 ,  scratch-    		*
+*	 ;      , 			*
+*	     ;  			*
+*	   (SR_TASK)   NextFrame (SR_FRAME), 		*
+*	  ,    				*
+****************************************************************************/
+#pragma once
+
+#include "Multithreading.h"
+#include "../Memory/LinearAllocator.h"
+#include "../Platform/Settings.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+enum ScratchReset : uint8_t{
+	SR_TASK = 0,										//       
+	SR_FRAME											//       NextFrame
+};
+
+
+class KERNEL_API WorkerContext{
+public:
+	static const size_t		STAT_SLOT_COUNT = 8;
+
+private:
+	WorkerContext(const WorkerContext&) = delete;
+	WorkerContext& operator=(const WorkerContext&) = delete;
+
+	static std::atomic<uint32_t>	s_scratchSize;
+	static std::atomic<uint8_t>		s_resetMode;
+	static std::atomic<uint32_t>	s_frame;
+
+public:
+	WorkerContext(uint16_t workerID);
+	~WorkerContext();
+
+	static WorkerContext*	Current();									//  ,  ; nullptr  
+
+	static void				SetScratchSize(uint32_t bytes);				//  ,   
+	static uint32_t			GetScratchSize();
+	static void				SetResetMode(ScratchReset mode);
+	static ScratchReset		GetResetMode();
+	static void				NextFrame();								//   SR_FRAME     
+
+	uint16_t				GetWorkerID() const;						// Thread::LocalID() 
+
+// Exception::NotEnoughMemory,   ;      
+	void*					Allocate(uint32_t size, uint32_t alignment=alignof(std::max_align_t));
+	template <typename T>
+	T*						Allocate(uint32_t count){
+		return static_cast<T*>( Allocate(static_cast<uint32_t>(count * sizeof(T)), alignof(T)) );
+	}
+	Memory::LinearAllocator&	GetScratch();
+	void					ResetScratch();								//    ,     ;    
+
+//     ; ThreadManager::GetStatSlotTotal     
+	void					AddToStatSlot(size_t slot, uint64_t value);
+	uint64_t				GetStatSlot(size_t slot) const;
+
+//     ;   fiberMark   
+	void					BeginTask(uint32_t fiberMark);
+
+private:
+	void					RollbackScratch(uint32_t fiberMark);
+
+//        
+	uint8_t						m_pad0[RGE_CACHE_LINE_SIZE];
+	Memory::LinearAllocator		m_scratch;
+	uint16_t					m_workerID;
+	uint32_t					m_frame;								//   
+	std::atomic<uint64_t>		m_statSlots[STAT_SLOT_COUNT];
+	uint8_t						m_pad1[RGE_CACHE_LINE_SIZE];
+};
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+/****************************************************************************
+*	  x86-64:      ,		*
+*	    ,   rsp - 		*
+*	  (swapcontext    			*
+*	sigprocmask);      , 		*
+*	     ucontext,  ucontext;			*
+*	   mmap,     ,			*
+*	    									*
+****************************************************************************/
+#include "../Settings.h"
+#ifdef RGE_LINUX
+
+#include "../../Multithreading/Fiber.h"
+#include "../../Exception/Exception.h"
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <cstdint>
+
+#if defined(__x86_64__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+	#define RGE_FIBER_ASM_SWITCH
+#endif
+
+
+#ifdef RGE_FIBER_ASM_SWITCH
+// RGE_FiberSwitch(from, to):  rbp, rbx, r12-r15, MXCSR    x87   ,
+//  rsp  *from        to;
+// RGE_FiberStart -    :  r13(r12)   
+extern "C" void RGE_FiberSwitch(void** from, void* to);
+extern "C" void RGE_FiberStart();
+
+asm(R"(
+	.text
+	.globl	RGE_FiberSwitch
+	.hidden	RGE_FiberSwitch
+	.type	RGE_FiberSwitch, @function
+RGE_FiberSwitch:
+	pushq	%rbp
+	pushq	%rbx
+	pushq	%r12
+	pushq	%r13
+	pushq	%r14
+	pushq	%r15
+	subq	$8, %rsp
+	stmxcsr	(%rsp)
+	fnstcw	4(%rsp)
+	movq	%rsp, (%rdi)
+	movq	%rsi, %rsp
+	ldmxcsr	(%rsp)
+	fldcw	4(%rsp)
+	addq	$8, %rsp
+	popq	%r15
+	popq	%r14
+	popq	%r13
+	popq	%r12
+	popq	%rbx
+	popq	%rbp
+	ret
+	.size	RGE_FiberSwitch, .-RGE_FiberSwitch
+
+	.globl	RGE_FiberStart
+	.hidden	RGE_FiberStart
+	.type	RGE_FiberStart, @function
+RGE_FiberStart:
+	movq	%r12, %rdi
+	callq	*%r13
+	ud2
+	.size	RGE_FiberStart, .-RGE_FiberStart
+)");
+#endif
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+#ifdef RGE_FIBER_ASM_SWITCH
+// m_context -  rsp;       
+void Fiber::CreateThreadContext(){
+	m_context = nullptr;
+}
+#else
+void Fiber::CreateThreadContext(){
+	m_context = new ucontext_t;
+}
+#endif
+
+void Fiber::CreateContext(){
+	size_t pageSize = static_cast<size_t>( sysconf(_SC_PAGESIZE) );
+	m_stackSize = (m_stackSize + pageSize - 1) / pageSize * pageSize;
+
+	m_stack = mmap(nullptr, m_stackSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+	if(m_stack == MAP_FAILED){
+		m_stack = nullptr;
+		RGE_Throw(Exception::NotEnoughMemory, "Can't allocate fiber stack");
+	}
+	mprotect(m_stack, pageSize, PROT_NONE);
+
+#ifdef RGE_FIBER_ASM_SWITCH
+//    ,      RGE_FiberSwitch;  ret  RGE_FiberStart rsp   16
+	auto entry = [](Fiber* fiber){
+		fiber->m_function(fiber->m_arg);
+	};
+	uint64_t* frame = reinterpret_cast<uint64_t*>( static_cast<char*>(m_stack) + pageSize + m_stackSize ) - 10;
+	frame[0] = 0x037F00001F80ull;						// MXCSR    x87  
+	frame[1] = 0;										// r15
+	frame[2] = 0;										// r14
+	frame[3] = reinterpret_cast<uint64_t>( static_cast<void(*)(Fiber*)>(entry) );	// r13
+	frame[4] = reinterpret_cast<uint64_t>(this);		// r12
+	frame[5] = 0;										// rbx
+	frame[6] = 0;										// rbp
+	frame[7] = reinterpret_cast<uint64_t>(&RGE_FiberStart);
+	m_context = frame;
+#else
+	ucontext_t* context = new ucontext_t;
+	getcontext(context);
+	context->uc_stack.ss_sp		= static_cast<char*>(m_stack) + pageSize;
+	context->uc_stack.ss_size	= m_stackSize;
+	context->uc_link			= nullptr;
+
+// makecontext   int-,      
+	auto entry = [](unsigned int high, unsigned int low){
+		Fiber* fiber = reinterpret_cast<Fiber*>( (static_cast<uintptr_t>(high) << 16 << 16) | low );
+		fiber->m_function(fiber->m_arg);
+	};
+	uintptr_t self = reinterpret_cast<uintptr_t>(this);
+	makecontext(context, reinterpret_cast<void(*)()>( static_cast<void(*)(unsigned int, unsigned int)>(entry) ), 2,
+				static_cast<unsigned int>(self >> 16 >> 16), static_cast<unsigned int>(self));
+
+	m_context = context;
+#endif
+}
+
+void Fiber::DestroyContext(){
+#ifndef RGE_FIBER_ASM_SWITCH
+	delete static_cast<ucontext_t*>(m_context);
+#endif
+	m_context = nullptr;
+
+	if(m_stack != nullptr){
+		munmap(m_stack, m_stackSize + static_cast<size_t>( sysconf(_SC_PAGESIZE) ));
+		m_stack = nullptr;
+	}
+}
+
+void Fiber::SwitchContext(Fiber& next){
+#ifdef RGE_FIBER_ASM_SWITCH
+	RGE_FiberSwitch(&m_context, next.m_context);
+#else
+	swapcontext(static_cast<ucontext_t*>(m_context), static_cast<ucontext_t*>(next.m_context));
+#endif
+}
+
+}
+}
+
+
+#endif		// RGE_LINUX
\ No newline at end of file
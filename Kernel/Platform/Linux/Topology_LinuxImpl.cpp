@@ -0,0 +1,161 @@
+/****************************************************************************
+*	    sysfs:							*
+*	/sys/devices/system/cpu/cpuN/topology -   ,					*
+*	/sys/devices/system/cpu/cpuN/cache/indexK -  ,					*
+*	/sys/devices/system/node/nodeX/cpulist - NUMA-						*
+****************************************************************************/
+#include "../Settings.h"
+#ifdef RGE_LINUX
+
+#include "../../Multithreading/Topology.h"
+#include <pthread.h>
+#include <sched.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+static const char*	SYSFS_CPU	= "/sys/devices/system/cpu/";
+static const char*	SYSFS_NODE	= "/sys/devices/system/node/";
+
+
+static bool ReadLine(const std::string& path, std::string& line){
+	std::ifstream file(path);
+	return file && std::getline(file, line) && !line.empty();
+}
+
+static bool ReadNumber(const std::string& path, uint32_t& value){
+	std::string line;
+	if(!ReadLine(path, line))
+		return false;
+	value = static_cast<uint32_t>( std::strtoul(line.c_str(), nullptr, 10) );
+	return true;
+}
+
+//  : "0-3,8,10-11"
+static std::vector<uint32_t> ParseCpuList(const std::string& list){
+	std::vector<uint32_t> cpus;
+	const char* str = list.c_str();
+	while(*str){
+		char* end;
+		uint32_t first = static_cast<uint32_t>( std::strtoul(str, &end, 10) );
+		if(end == str)
+			break;
+		uint32_t last = first;
+		if(*end == '-'){
+			str = end + 1;
+			last = static_cast<uint32_t>( std::strtoul(str, &end, 10) );
+		}
+		for(uint32_t cpu = first; cpu <= last; cpu++)
+			cpus.push_back(cpu);
+
+		str = (*end == ',') ? end + 1 : end;
+	}
+	return cpus;
+}
+
+//     -  
+static bool ReadDomain(const std::string& path, uint32_t& domain){
+	std::string line;
+	if(!ReadLine(path, line))
+		return false;
+
+	std::vector<uint32_t> cpus = ParseCpuList(line);
+	if(cpus.empty())
+		return false;
+	domain = cpus.front();
+	return true;
+}
+
+static void ReadCacheDomains(const std::string& cpuDir, LogicalCpu& cpu){
+	for(int indx = 0; ; indx++){
+		std::string cacheDir = cpuDir + "cache/index" + std::to_string(indx) + "/";
+		uint32_t level;
+		std::string type;
+		if(!ReadNumber(cacheDir + "level", level) || !ReadLine(cacheDir + "type", type))
+			break;
+		if(type == "Instruction")
+			continue;
+
+		if(level == 2)	ReadDomain(cacheDir + "shared_cpu_list", cpu.l2Domain);
+		if(level == 3)	ReadDomain(cacheDir + "shared_cpu_list", cpu.l3Domain);
+	}
+}
+
+
+bool Topology::DetectPlatform(){
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if(sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+		return false;
+
+	std::string online;
+	if(!ReadLine(std::string(SYSFS_CPU) + "online", online))
+		return false;
+
+	for(uint32_t id : ParseCpuList(online)){
+		if(id >= CPU_SETSIZE || !CPU_ISSET(id, &allowed))
+			continue;
+
+		std::string cpuDir = std::string(SYSFS_CPU) + "cpu" + std::to_string(id) + "/";
+		LogicalCpu cpu;
+		cpu.id		 = id;
+		cpu.core	 = id;
+		cpu.package	 = 0;
+		cpu.l2Domain = id;
+		cpu.l3Domain = id;
+		cpu.numaNode = 0;
+		cpu.smtIndex = 0;
+
+		ReadNumber(cpuDir + "topology/physical_package_id", cpu.package);
+		if(!ReadDomain(cpuDir + "topology/core_cpus_list", cpu.core))				//  
+			ReadDomain(cpuDir + "topology/thread_siblings_list", cpu.core);
+		cpu.l2Domain = cpu.core;
+		cpu.l3Domain = cpu.package;
+		ReadCacheDomains(cpuDir, cpu);
+
+		m_cpus.push_back(cpu);
+	}
+
+//      NUMA
+	std::string nodes;
+	if(!ReadLine(std::string(SYSFS_NODE) + "online", nodes))
+		return !m_cpus.empty();
+
+	for(uint32_t node : ParseCpuList(nodes)){
+		std::string list;
+		if(!ReadLine(std::string(SYSFS_NODE) + "node" + std::to_string(node) + "/cpulist", list))
+			continue;
+
+		for(uint32_t id : ParseCpuList(list))
+			for(auto& cpu : m_cpus)
+				if(cpu.id == id)
+					cpu.numaNode = node;
+	}
+
+	return !m_cpus.empty();
+}
+
+
+bool Topology::SetThreadAffinity(std::thread& thread, uint32_t cpu){
+	if(cpu >= CPU_SETSIZE)
+		return false;
+
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+}
+
+}
+}
+
+
+#endif		// RGE_LINUX
\ No newline at end of file
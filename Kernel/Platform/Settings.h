@@ -5,4 +5,11 @@
 
 #if defined(__WIN32__) || defined(_WIN32)
 	#define RGE_WINDOWS
-#endif
\ No newline at end of file
+#endif
+
+#if defined(__linux__)
+	#define RGE_LINUX
+#endif
+
+//  -;        
+#define RGE_CACHE_LINE_SIZE		64
\ No newline at end of file
@@ -0,0 +1,58 @@
+/****************************************************************************
+*	  Fiber API: ,    (, 		*
+*	),      				*
+****************************************************************************/
+#include "..\Settings.h"
+#ifdef RGE_WINDOWS
+
+#include "..\..\Multithreading\Fiber.h"
+#include "..\..\Exception\Exception.h"
+#include <windows.h>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+void Fiber::CreateThreadContext(){
+	if(IsThreadAFiber()){
+		m_context	= GetCurrentFiber();
+		m_isThread	= false;							//    -    
+		return;
+	}
+
+	m_context = ConvertThreadToFiber(nullptr);
+	RGE_Assert(m_context != nullptr, Exception::WrongState, "Can't convert thread to fiber");
+}
+
+void Fiber::CreateContext(){
+	auto entry = [](LPVOID arg){
+		Fiber* fiber = static_cast<Fiber*>(arg);
+		fiber->m_function(fiber->m_arg);
+	};
+
+	m_context = CreateFiber(m_stackSize, static_cast<LPFIBER_START_ROUTINE>(entry), this);
+	RGE_Assert(m_context != nullptr, Exception::NotEnoughMemory, "Can't create fiber");
+}
+
+void Fiber::DestroyContext(){
+	if(m_context == nullptr)
+		return;
+
+	if(m_function != nullptr)
+		DeleteFiber(m_context);
+	else if(m_isThread)
+		ConvertFiberToThread();
+	m_context = nullptr;
+}
+
+void Fiber::SwitchContext(Fiber& next){
+	SwitchToFiber(next.m_context);
+}
+
+}
+}
+
+
+#endif		// RGE_WINDOWS
\ No newline at end of file
@@ -0,0 +1,118 @@
+/****************************************************************************
+*	    GetLogicalProcessorInformationEx;	*
+*	    0 ( 64  )	*
+****************************************************************************/
+#include "..\Settings.h"
+#ifdef RGE_WINDOWS
+
+#include "..\..\Multithreading\Topology.h"
+#include <windows.h>
+#include <vector>
+
+
+namespace RGE
+{
+namespace Multithreading
+{
+
+static uint32_t LowestCpu(KAFFINITY mask){
+	for(uint32_t id = 0; id < sizeof(KAFFINITY) * 8; id++)
+		if(mask & (KAFFINITY(1) << id))
+			return id;
+	return 0;
+}
+
+
+bool Topology::DetectPlatform(){
+	DWORD_PTR processMask, systemMask;
+	if(!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+		return false;
+
+	DWORD size = 0;
+	GetLogicalProcessorInformationEx(RelationAll, nullptr, &size);
+	if(GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+		return false;
+
+	std::vector<char> buffer(size);
+	auto info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data());
+	if(!GetLogicalProcessorInformationEx(RelationAll, info, &size))
+		return false;
+
+	for(uint32_t id = 0; id < sizeof(KAFFINITY) * 8; id++){
+		if(!(processMask & (KAFFINITY(1) << id)))
+			continue;
+
+		LogicalCpu cpu;
+		cpu.id		 = id;
+		cpu.core	 = id;
+		cpu.package	 = 0;
+		cpu.l2Domain = id;
+		cpu.l3Domain = 0;
+		cpu.numaNode = 0;
+		cpu.smtIndex = 0;
+		m_cpus.push_back(cpu);
+	}
+
+//   ,   
+	for(DWORD offset = 0; offset < size; ){
+		auto entry = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+		offset += entry->Size;
+
+		KAFFINITY	mask	= 0;
+		uint32_t	value	= 0;
+		uint32_t LogicalCpu::*field = nullptr;
+
+		switch(entry->Relationship){
+		case RelationProcessorCore:
+			if(entry->Processor.GroupMask[0].Group != 0)	continue;
+			mask	= entry->Processor.GroupMask[0].Mask;
+			value	= LowestCpu(mask);
+			field	= &LogicalCpu::core;
+			break;
+
+		case RelationProcessorPackage:
+			if(entry->Processor.GroupMask[0].Group != 0)	continue;
+			mask	= entry->Processor.GroupMask[0].Mask;
+			value	= LowestCpu(mask);
+			field	= &LogicalCpu::package;
+			break;
+
+		case RelationCache:
+			if(entry->Cache.GroupMask.Group != 0 || entry->Cache.Type == CacheInstruction)	continue;
+			if(entry->Cache.Level != 2 && entry->Cache.Level != 3)							continue;
+			mask	= entry->Cache.GroupMask.Mask;
+			value	= LowestCpu(mask);
+			field	= (entry->Cache.Level == 2) ? &LogicalCpu::l2Domain : &LogicalCpu::l3Domain;
+			break;
+
+		case RelationNumaNode:
+			if(entry->NumaNode.GroupMask.Group != 0)	continue;
+			mask	= entry->NumaNode.GroupMask.Mask;
+			value	= entry->NumaNode.NodeNumber;
+			field	= &LogicalCpu::numaNode;
+			break;
+
+		default:
+			continue;
+		}
+
+		for(auto& cpu : m_cpus)
+			if(mask & (KAFFINITY(1) << cpu.id))
+				cpu.*field = value;
+	}
+
+	return !m_cpus.empty();
+}
+
+
+bool Topology::SetThreadAffinity(std::thread& thread, uint32_t cpu){
+	if(cpu >= sizeof(DWORD_PTR) * 8)
+		return false;
+	return SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << cpu) != 0;
+}
+
+}
+}
+
+
+#endif		// RGE_WINDOWS
\ No newline at end of file
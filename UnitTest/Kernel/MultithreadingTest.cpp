@@ -3,7 +3,37 @@
 #include <Multithreading\Task.h>
 #include <Multithreading\Thread.h>
 #include <Multithreading\ThreadManager.h>
+#include <Multithreading\SafeContainer.h>
 #include <Multithreading\List.h>
+#include <Multithreading\RcuContainer.h>
+#include <Multithreading\MPMCQueue.h>
+#include <Multithreading\SPSCQueue.h>
+#include <Multithreading\MPSCQueue.h>
+#include <Multithreading\SegmentedQueue.h>
+#include <Multithreading\ConcurrentHashMap.h>
+#include <Multithreading\TaskPool.h>
+#include <Multithreading\InplaceFunction.h>
+#include <Multithreading\EventCount.h>
+#include <Multithreading\CompletionCounter.h>
+#include <Multithreading\Spinlock.h>
+#include <Multithreading\TicketLock.h>
+#include <Multithreading\MCSLock.h>
+#include <Multithreading\BravoRWLock.h>
+#include <Multithreading\EpochManager.h>
+#include <Multithreading\HazardPointer.h>
+#include <Multithreading\Coroutine.h>
+#include <Multithreading\AsyncEvent.h>
+#include <Multithreading\Topology.h>
+#include <Multithreading\SchedulingPolicy.h>
+#include <Multithreading\Fiber.h>
+#include <Multithreading\Telemetry.h>
+#include <Multithreading\CancellationToken.h>
+#include <Multithreading\TaskGroup.h>
+#include <Multithreading\TimerWheel.h>
+#include <Multithreading\Pipeline.h>
+#include <Multithreading\JobGraph.h>
+#include <Multithreading\BlockingRegion.h>
+#include <Multithreading\WorkerContext.h>
 #include <Exception\Exception.h>
 #include <memory>
 #include <iostream>
@@ -97,9 +127,93 @@ public:
 
 		for(int i = 0; i<mt1.GetTaskCount(); i++)
 			mt1.GetSubtask(i)->Wait();
+
+		//     
+		Task<int> t4([](){ return 1; });
+		bool cancelled = false;
+		RGE_Assert(t4.TryDiscard(), Exception::TestFailed, "Queued task was not discarded");
+		try{ t4.GetResult(); }
+		catch(Exception::Cancelled&){ cancelled = true; }
+		RGE_Assert(cancelled, Exception::TestFailed, "Discarded task returned a result");
+
+		Task<void> t5([](){});
+		cancelled = false;
+		RGE_Assert(t5.TryDiscard(), Exception::TestFailed, "Queued task was not discarded");
+		try{ t5.GetResult(); }
+		catch(Exception::Cancelled&){ cancelled = true; }
+		RGE_Assert(cancelled, Exception::TestFailed, "Discarded void task completed silently");
+	}
+#pragma endregion
+
+#pragma region TaskPoolTest
+	TEST_METHOD(TaskPoolTest){
+		//     
+		int a = 1, b = 2;
+		auto smallFunc = [&a, &b](){ return a + b; };
+		RGE_Assert(InplaceFunction<int()>::IsStoredInplace<decltype(smallFunc)>(), Exception::TestFailed, "Small functor wasn't stored inplace");
+
+		InplaceFunction<int()> f1(smallFunc);
+		InplaceFunction<int()> f2(std::move(f1));
+		RGE_Assert(!f1 && f2() == 3, Exception::TestFailed, "InplaceFunction move failed");
+
+		//      
+		void* block = TaskPool::Allocate(100);
+		TaskPool::Deallocate(block);
+		void* reused = TaskPool::Allocate(100);
+		TaskPool::Deallocate(reused);
+		RGE_Assert(block == reused, Exception::TestFailed, "Block wasn't reused");
+
+		//     ,    
+		const int taskCount = 1000;
+		std::atomic_int counter(0);
+		for(int round = 0; round<3; round++){
+			std::vector<TaskProxy<int>> tasks;
+			for(int i = 0; i<taskCount; i++)
+				tasks.push_back(ThreadManager::Instance().Execute<int>([&counter, i](){ counter++; return i; }));
+
+			int64_t sum = 0;
+			for(auto& task : tasks)
+				sum += task.GetResult();
+			RGE_Assert(sum == int64_t(taskCount) * (taskCount - 1) / 2, Exception::TestFailed, "Wrong task results");
+		}
+		RGE_Assert(counter == 3 * taskCount, Exception::TestFailed, "Not all tasks were performed");
+	}
+#pragma endregion
+
+#pragma region AtomicWaitTest
+	TEST_METHOD(AtomicWaitTest){
+		//    EventCount,     
+		EventCount event;
+		std::atomic_bool flag(false);
+		std::thread waiter([&](){ event.Await([&](){ return flag.load(); }); });
+		flag.store(true);
+		event.NotifyAll();
+		waiter.join();
+
+		//     ,    
+		const int taskCount = 100;
+		std::atomic_int counter(0);
+		for(int round = 0; round<3; round++){
+			std::vector<TaskProxy<void>> tasks;
+			for(int i = 0; i<taskCount; i++)
+				tasks.push_back(ThreadManager::Instance().Execute<void>([&counter](){ counter++; }, TP_MINIMAL));
+			bool discarded = ThreadManager::Instance().DiscardTask(tasks.back());
+
+			ThreadManager::Instance().WaitAllTasksCompleted();
+			RGE_Assert(ThreadManager::Instance().AreAllTasksCompleted(), Exception::TestFailed, "Completion counter isn't zero");
+			for(auto& task : tasks)
+				RGE_Assert(task.GetState() >= TS_READY, Exception::TestFailed, "WaitAllTasksCompleted returned before task completion");
+			RGE_Assert(!discarded || tasks.back().GetState() == TS_DISCARDED, Exception::TestFailed, "Task wasn't discarded");
+
+			RGE_Assert(ThreadManager::Instance().RerunTask(tasks.front()), Exception::TestFailed, "Task wasn't rerun");
+			ThreadManager::Instance().WaitAllTasksCompleted();
+			RGE_Assert(tasks.front().GetState() == TS_READY, Exception::TestFailed, "Rerun task wasn't completed");
+		}
+		RGE_Assert(counter >= 3 * taskCount, Exception::TestFailed, "Not all tasks were performed");
 	}
 #pragma endregion
 
+
 #pragma region ThreadTest
 	static void SleepFor(int sec){
 		std::mutex mutex;
@@ -368,6 +482,22 @@ public:
 
 		printf("====== ThreadManager Test Finished ======\n\n");
 	}
+
+	TEST_METHOD(ChangeTaskPriorityTest){
+		ThreadManager& manager = ThreadManager::Instance();
+		std::atomic_int runs(0);
+
+		//      ,     RerunTask
+		auto task = manager.Execute<int>([&runs](){ return ++runs; }, TP_MINIMAL);
+		manager.ChangeTaskPriority(task, TP_MAXIMAL);
+		manager.WaitAllTasksCompleted();
+		RGE_Assert(runs.load() == 1, Exception::TestFailed, "Task ran more than once");
+
+		RGE_Assert(manager.RerunTask(task), Exception::TestFailed, "Task wasn't rerun");
+		manager.WaitAllTasksCompleted();
+		RGE_Assert(task.GetResult() == 2 && runs.load() == 2, Exception::TestFailed, "Stale copy ran the rerun");
+		RGE_Assert(manager.GetQueuedTaskCount() == 0, Exception::TestFailed, "Stale copy is still counted");
+	}
 #pragma endregion
 
 #pragma region RWLockTest
@@ -423,104 +553,1093 @@ public:
 
 		for(int i = 0; i<writerCount; i++)
 			RGE_Assert(writerRrealLog[i] == m_writerLog[i], Exception::TestFailed, "RWLockTest Failed");
+
+		//      ;    
+		RWSpinlock rwlock;
+		std::atomic_int acquired(0);
+		rwlock.LockWrite();
+		std::vector<std::thread> waiters;
+		for(int i = 0; i<4; i++)
+			waiters.emplace_back([&, i](){
+				if(i & 1)	{ ReadLockGuard guard(rwlock); }
+				else		{ WriteLockGuard guard(rwlock); }
+				acquired++;
+			});
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		rwlock.UnlockWrite();
+		for(auto& th : waiters)
+			th.join();
+		RGE_Assert(acquired == 4 && !rwlock.IsLockedRead() && !rwlock.IsLockedWrite(), Exception::TestFailed, "Parked waiters were not woken");
+	}
+#pragma endregion
+
+#pragma region BravoRWLockTest
+	TEST_METHOD(BravoRWLockTest){
+		BravoRWLock rwlock;
+		int64_t values[2] = {0, 0};
+		std::atomic_int inconsistentReads(0);
+
+		//      ,      
+		std::vector<std::thread> threads;
+		for(int rank = 0; rank<6; rank++)
+			threads.emplace_back([&, rank](){
+				for(int i = 0; i<50000; i++){
+					if(rank == 0 && i % 100 == 0){
+						WriteLockGuard guard(rwlock);
+						values[0]++;
+						values[1]++;
+					}
+					else{
+						ReadLockGuard guard(rwlock);
+						if(values[0] != values[1])
+							inconsistentReads++;
+					}
+				}
+			});
+		for(auto& th : threads)
+			th.join();
+
+		RGE_Assert(inconsistentReads == 0, Exception::TestFailed, "Reader observed a partial write");
+		RGE_Assert(values[0] == 500, Exception::TestFailed, "Lost write");
+
+		//         
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		{ ReadLockGuard guard(rwlock); }
+		RGE_Assert(rwlock.IsReadBiased(), Exception::TestFailed, "Read bias wasn't restored");
 	}
 #pragma endregion
 
-//TODO:     List<uint32_t>
-#if 0 
+
+#pragma region LockTest
+	template <class Lock, class LockFunction>
+	static void CheckMutualExclusion(Lock& lock, LockFunction lockedIncrement){
+		const int threadCount = 8;
+		const int iterCount = 20000;
+		int counter = 0;
+
+		std::vector<std::thread> threads;
+		for(int i = 0; i<threadCount; i++)
+			threads.emplace_back([&](){
+				for(int j = 0; j<iterCount; j++)
+					lockedIncrement(lock, counter);
+			});
+		for(auto& th : threads)
+			th.join();
+
+		RGE_Assert(counter == threadCount * iterCount, Exception::TestFailed, "Lock doesn't provide mutual exclusion");
+	}
+
+	TEST_METHOD(LockTest){
+		Spinlock spinlock;
+		RGE_Assert(spinlock.try_lock(), Exception::TestFailed, "Spinlock::try_lock failed on free lock");
+		RGE_Assert(!spinlock.try_lock(), Exception::TestFailed, "Spinlock::try_lock succeeded on locked lock");
+		spinlock.unlock();
+
+		TicketLock ticketLock;
+		RGE_Assert(ticketLock.try_lock() && !ticketLock.try_lock(), Exception::TestFailed, "TicketLock::try_lock failed");
+		ticketLock.unlock();
+
+		MCSLock mcsLock;
+		MCSLock::Node node1, node2;
+		RGE_Assert(mcsLock.try_lock(node1) && !mcsLock.try_lock(node2), Exception::TestFailed, "MCSLock::try_lock failed");
+		mcsLock.unlock(node1);
+
+		CheckMutualExclusion(spinlock, [](Spinlock& lock, int& counter){ std::lock_guard<Spinlock> guard(lock); counter++; });
+		CheckMutualExclusion(ticketLock, [](TicketLock& lock, int& counter){ std::lock_guard<TicketLock> guard(lock); counter++; });
+		CheckMutualExclusion(mcsLock, [](MCSLock& lock, int& counter){ MCSLock::Guard guard(lock); counter++; });
+	}
+#pragma endregion
+
+
+#pragma region QueueTest
+	template <class Queue, class PushFunction>
+	static void QueueStress(Queue& queue, PushFunction push, const char* name){
+		const int producerCount = 4;
+		const int consumerCount = 4;
+		const int elemCount = 100000;
+
+		std::atomic<int64_t>	sum(0);
+		std::atomic_int			popped(0);
+		std::vector<std::thread> threads;
+
+		for(int p = 0; p<producerCount; p++)
+			threads.emplace_back([&](){
+				for(int i = 1; i<=elemCount; i++)
+					push(queue, i);
+			});
+
+		for(int c = 0; c<consumerCount; c++)
+			threads.emplace_back([&](){
+				int val;
+				while(popped < producerCount*elemCount){
+					if(queue.try_pop(&val)){
+						sum += val;
+						popped++;
+					}
+				}
+			});
+
+		for(auto& th : threads)
+			th.join();
+
+		int64_t expected = int64_t(producerCount) * elemCount * (elemCount + 1) / 2;
+		printf("%s: sum = %lld, expected = %lld\n", name, sum.load(), expected);
+		RGE_Assert(sum == expected, Exception::TestFailed, "Some values were lost or duplicated");
+		RGE_Assert(queue.empty(), Exception::TestFailed, "Queue is not empty");
+	}
+
+	TEST_METHOD(QueueTest){
+		MPMCQueue<int> boundedQueue(256);
+		QueueStress(boundedQueue, [](MPMCQueue<int>& q, int val){
+			while(!q.try_push(val))
+				std::this_thread::yield();
+		}, "MPMCQueue");
+
+		SegmentedQueue<int> unboundedQueue(64);
+		QueueStress(unboundedQueue, [](SegmentedQueue<int>& q, int val){
+			q.push(val);
+		}, "SegmentedQueue");
+	}
+#pragma endregion
+
+#pragma region HashMapTest
+	TEST_METHOD(HashMapTest){
+		ConcurrentHashMap<uint32_t, uint64_t> map(8);
+		const uint32_t elemCount = 50000;
+		std::atomic_int writersDone(0);
+		std::atomic_int wrongValues(0);
+		std::vector<std::thread> threads;
+
+		//       ,   
+		for(uint32_t w = 0; w<2; w++)
+			threads.emplace_back([&, w](){
+				for(uint32_t i = w; i<elemCount; i += 2){
+					map.insert(i, uint64_t(i) * 3);
+					if(i % 5 == 0)
+						map.erase(i);
+				}
+				writersDone++;
+			});
+
+		for(int r = 0; r<4; r++)
+			threads.emplace_back([&](){
+				uint64_t val;
+				while(writersDone < 2)
+					for(uint32_t i = 0; i<elemCount; i += 31)
+						if(map.find(i, &val) && val != uint64_t(i) * 3)
+							wrongValues++;
+			});
+
+		for(auto& th : threads)
+			th.join();
+
+		size_t count = 0;
+		map.for_each([&](uint32_t key, uint64_t val){
+			if(val != uint64_t(key) * 3 || key % 5 == 0)
+				wrongValues++;
+			count++;
+			return true;
+		});
+
+		printf("HashMap: size = %zu, wrong values = %i\n", map.size(), wrongValues.load());
+		RGE_Assert(wrongValues == 0, Exception::TestFailed, "Wrong value was read");
+		RGE_Assert(count == elemCount - elemCount/5 && map.size() == count, Exception::TestFailed, "Wrong map size");
+
+		//  :   ,  
+		ConcurrentHashMap<std::string, int> names(4);
+		std::vector< std::pair<std::string, int> > elems;
+		for(int i = 0; i<1000; i++)
+			elems.emplace_back(std::to_string(i), i);
+
+		int val;
+		RGE_Assert(names.insert_range(elems.begin(), elems.end()) == elems.size(), Exception::TestFailed, "insert_range failed");
+		RGE_Assert(names.insert_range(elems.begin(), elems.end()) == 0, Exception::TestFailed, "Keys were inserted twice");
+		RGE_Assert(names.find("512", &val) && val == 512, Exception::TestFailed, "Key wasn't found");
+		RGE_Assert(names.erase("512") && !names.contains("512"), Exception::TestFailed, "Key wasn't erased");
+	}
+#pragma endregion
+
+#pragma region ListTest
 //      
 	TEST_METHOD(SafeList_PushPopTest){
-		//SafeContainer< std::list<uint64_t> > list;
-		List<uint32_t>						list;
-		std::vector<int>					pushCounter;
-		SafeContainer< std::vector<int>	>	popCounter;
-
-		int elemCount = 5000;
-		uint8_t workersPerAction = 1;
-		ThreadManager::Instance().SetWorkersCount(4 * workersPerAction);
-		pushCounter.resize(2 * workersPerAction);
-		popCounter.resize(2 * workersPerAction);
-
-		//Logging::LogManager::Instance().DisableMessageType(Logging::MT_Debug);
-
-		// push_front
-		auto pushFrontTask = ThreadManager::Instance().Execute<void>([&](int rank, int){
-			int globalRank = rank;
-			for(int i = 0; i<elemCount; i++){
-				list.push_front(globalRank);
-				pushCounter[globalRank]++;
-				std::this_thread::sleep_for(std::chrono::milliseconds(2));
-			}
-		}, workersPerAction);
-
-		// push_back
-		auto pushBackTask = ThreadManager::Instance().Execute<void>([&](int rank, int){
-			/*int globalRank = rank + workersPerAction;
-			for(int i=0; i<elemCount; i++){
-			list.push_back(globalRank);
-			pushCounter[globalRank]++;
-			std::this_thread::sleep_for(std::chrono::milliseconds(2));
-			}*/
-		}, workersPerAction);
+		List<uint32_t>					list;
+		std::vector<std::atomic_int>	pushCounter(4);
+		std::vector<std::atomic_int>	popCounter(4);
+		std::atomic_int					pushersDone(0);
+
+		const int elemCount = 20000;
+		ThreadManager::Instance().SetWorkersCount(4);
 
-		// pop_front
-		auto popFrontTask = ThreadManager::Instance().Execute<void>([&](int, int){
+		// push_front / push_back;   -    
+		auto pushTask = ThreadManager::Instance().Execute<void>([&](int rank, int){
 			for(int i = 0; i<elemCount; i++){
-				uint32_t val;
-				while(!list.pop_front(&val))
-					std::this_thread::sleep_for(std::chrono::milliseconds(2));
-				popCounter[val]++;
-				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+				if(rank == 0)	list.push_front(rank);
+				else			list.push_back(rank);
+				pushCounter[rank]++;
 			}
-		}, workersPerAction);
+			pushersDone++;
+		}, 2);
 
-		// pop_back
-		auto popBackTask = ThreadManager::Instance().Execute<void>([&](int, int){
-			/*for(int i=0; i<elemCount; i++){
+		// pop_front / pop_back
+		auto popTask = ThreadManager::Instance().Execute<void>([&](int rank, int){
 			uint32_t val;
-			while(!list.pop_back(&val))
-			std::this_thread::sleep_for(std::chrono::milliseconds(2));
-			popCounter[val]++;
-			std::this_thread::sleep_for(std::chrono::milliseconds(2));
-			}*/
-		}, workersPerAction);
-
-		while(pushBackTask.GetTaskState() < TS_READY ||
-			pushFrontTask.GetTaskState()< TS_READY ||
-			popBackTask.GetTaskState()  < TS_READY ||
-			popFrontTask.GetTaskState() < TS_READY)
-		{
-			for(int i = 0; i<2 * workersPerAction; i++){
-				if(pushCounter[i] == popCounter[i])
-					int a = 5;
-				printf("%6i / %6i  ", pushCounter[i], popCounter[i]);
+			while(pushersDone < 2 || !list.empty()){
+				bool popped = rank == 0 ? list.pop_front(&val) : list.pop_back(&val);
+				if(popped)
+					popCounter[val]++;
+				else
+					std::this_thread::yield();
 			}
-			printf("\r");
-			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}, 2);
+
+		pushTask.Wait();
+		popTask.Wait();
+		for(int i = 0; i<2; i++){
+			pushTask.GetSubtask(i).GetResult();
+			popTask.GetSubtask(i).GetResult();
 		}
-		for(int i = 0; i<2 * workersPerAction; i++)
-			printf("%6i / %6i  ", pushCounter[i], popCounter[i]);
+
+		for(int i = 0; i<2; i++)
+			printf("%6i / %6i  ", pushCounter[i].load(), popCounter[i].load());
 		printf("\n");
 
+		RGE_Assert(list.empty(), Exception::TestFailed, "List is not empty");
+		for(int i = 0; i<2; i++)
+			RGE_Assert(pushCounter[i] == popCounter[i], Exception::TestFailed, "Not all values was processed correctly");
+	}
+
+//      ,     ElementRef
+	TEST_METHOD(SafeList_FindRemoveTest){
+		List<uint32_t> list;
+		for(uint32_t i = 0; i<100; i++)
+			list.push_back(i);
+
+		auto ref = list.find_if([](uint32_t val){ return val == 42; });
+		RGE_Assert(ref && *ref == 42, Exception::TestFailed, "Element wasn't found");
+		RGE_Assert(list.remove(ref), Exception::TestFailed, "Element wasn't removed");
+		RGE_Assert(!list.remove(ref), Exception::TestFailed, "Element was removed twice");
+		RGE_Assert(ref.IsRemoved() && *ref == 42, Exception::TestFailed, "Removed element is unavailable");
+
+		uint32_t sum = 0;
+		list.for_each([&](uint32_t val){ sum += val; return true; });
+		RGE_Assert(sum == 99*100/2 - 42, Exception::TestFailed, "Removed element is still visible");
+		RGE_Assert(list.try_erase(7) && !list.try_erase(7), Exception::TestFailed, "try_erase failed");
+		RGE_Assert(list.size() == 98, Exception::TestFailed, "Wrong list size");
+
+		//   ;       
+		List<uint32_t>::ElementRef survivor;
+		{
+			EpochGuard guard;
+			List<uint32_t> scoped;
+			scoped.push_back(5);
+			survivor = scoped.find_if([](uint32_t val){ return val == 5; });
+		}
+		RGE_Assert(survivor && *survivor == 5 && survivor.IsRemoved(), Exception::TestFailed, "Element was freed with the list");
+		survivor.Release();
+	}
+#pragma endregion
+
+#pragma region RcuContainerTest
+	TEST_METHOD(RcuContainerTest){
+		RcuContainer<std::vector<int>> config(std::vector<int>(16, 0));
+		std::atomic_bool stop(false);
+		std::atomic_int inconsistentReads(0);
+
+		//       
+		std::vector<std::thread> readers;
+		for(int i = 0; i<4; i++)
+			readers.emplace_back([&](){
+				while(!stop){
+					auto snapshot = config.snapshot();
+					for(int val : *snapshot)
+						if(val != snapshot->front())
+							inconsistentReads++;
+				}
+			});
+
+		for(int version = 1; version<=1000; version++)
+			config.update([version](std::vector<int>& values){
+				for(auto& val : values)
+					val = version;
+				return true;
+			});
+		stop = true;
+		for(auto& th : readers)
+			th.join();
+
+		RGE_Assert(inconsistentReads == 0, Exception::TestFailed, "Reader observed a partially updated version");
+		RGE_Assert(config.snapshot()->front() == 1000, Exception::TestFailed, "Last version wasn't published");
+
+		config.push_back(42);
+		RGE_Assert(config.size() == 17 && config.try_erase(42) && !config.try_erase(42), Exception::TestFailed, "push_back/try_erase failed");
+		config.synchronize();
+	}
+#pragma endregion
+
+#pragma region ReclamationTest
+	struct Tracked{
+		Tracked(std::atomic_int& counter) : alive(counter){ alive++; }
+		~Tracked(){ alive--; }
+
+		std::atomic_int&	alive;
+	};
+
+	TEST_METHOD(ReclamationTest){
+		std::atomic_int alive(0);
+		EpochManager& epochs = EpochManager::Instance();
+
+		//   ,      
+		std::atomic_int stage(0);
+		std::thread reader([&](){
+			EpochGuard guard;
+			stage = 1;
+			while(stage != 2)
+				std::this_thread::yield();
+		});
+		while(stage != 1)
+			std::this_thread::yield();
+
+		epochs.Retire(new Tracked(alive));
+		for(int i = 0; i<8; i++)
+			epochs.Quiesce();
+		RGE_Assert(alive == 1, Exception::TestFailed, "Object was freed inside a critical section");
+
+		stage = 2;
+		reader.join();
+		epochs.Synchronize();
+		RGE_Assert(alive == 0, Exception::TestFailed, "Object wasn't freed after grace period");
+
+		//  hazard pointer'     
+		std::atomic<Tracked*> shared(new Tracked(alive));
+		HazardPointer hazard;
+		Tracked* obj = hazard.Protect(shared);
+		shared = nullptr;
+
+		HazardPointerDomain::Instance().Retire(obj);
+		HazardPointerDomain::Instance().Scan();
+		RGE_Assert(alive == 1, Exception::TestFailed, "Protected object was freed");
+
+		hazard.Reset();
+		HazardPointerDomain::Instance().Scan();
+		RGE_Assert(alive == 0, Exception::TestFailed, "Unprotected object wasn't freed");
+	}
+#pragma endregion
+
+#pragma region CoroutineTest
+	static Coroutine<int> Twice(int x){
+		co_return 2*x;
+	}
+
+	static Coroutine<int> LoadAsync(AsyncEvent& ioCompleted){
+		TaskProxy<int> task = ThreadManager::Instance().Execute<int>([](){ return 10; });
+		int fromTask = co_await task;
+		int fromCoroutine = co_await Twice(fromTask);
+
+		co_await ioCompleted;
+		co_await Delay(std::chrono::milliseconds(1));
+		co_return fromCoroutine + 1;
+	}
+
+	TEST_METHOD(CoroutineTest){
+		RGE_Assert(Twice(21).GetResult() == 42, Exception::TestFailed, "Coroutine wasn't run inline");
+
+		AsyncEvent ioCompleted;
+		Coroutine<int> load = ThreadManager::Instance().Spawn(LoadAsync(ioCompleted));
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		RGE_Assert(!load.IsReady(), Exception::TestFailed, "Coroutine didn't wait for the event");
+
+		ioCompleted.Set();
+		RGE_Assert(load.GetResult() == 21, Exception::TestFailed, "Wrong coroutine result");
+	}
+#pragma endregion
+
+#pragma region TopologyTest
+	TEST_METHOD(TopologyTest){
+		const Topology& topology = Topology::Instance();
+		uint32_t count = topology.GetLogicalCpuCount();
+		RGE_Assert(count > 0, Exception::TestFailed, "No logical cpus detected");
+		RGE_Assert(topology.GetCoreCount() <= count, Exception::TestFailed, "More cores than logical cpus");
+
+		//   -   ,    SMT-
+		const std::vector<uint32_t>& placement = topology.GetPlacementOrder();
+		RGE_Assert(placement.size() == count, Exception::TestFailed, "Wrong placement order size");
+		for(uint32_t i=0; i<topology.GetCoreCount(); i++){
+			const LogicalCpu* cpu = topology.FindCpu(placement[i]);
+			RGE_Assert(cpu != nullptr && cpu->smtIndex == 0, Exception::TestFailed, "SMT sibling placed before free cores");
+		}
+		RGE_Assert(topology.GetDistance(placement[0], placement[0]) == CD_SAME_CPU, Exception::TestFailed, "Wrong distance");
+
+		Thread th;
+		RGE_Assert(th.GetCpu() == Topology::INVALID_CPU, Exception::TestFailed, "New thread is pinned");
+		if(th.SetAffinity(placement[0]))
+			RGE_Assert(th.GetCpu() == placement[0], Exception::TestFailed, "Thread cpu wasn't stored");
+		RGE_Assert(!th.SetAffinity(Topology::INVALID_CPU), Exception::TestFailed, "Pinned to invalid cpu");
+	}
+#pragma endregion
+
+#pragma region SchedulingPolicyTest
+	static ScheduledTask MakeEntry(int value, TaskPriority priority, IScheduler::Clock::duration age, IScheduler::Clock::time_point deadline = ScheduledTask::NO_DEADLINE){
+		ScheduledTask entry;
+		entry.task		= MakeTask<int>([value](){ return value; });
+		entry.priority	= priority;
+		entry.queued	= IScheduler::Clock::now() - age;
+		entry.deadline	= deadline;
+		return entry;
+	}
+
+	static int PopValue(SchedulingPolicy& policy){
+		ScheduledTask entry;
+		RGE_Assert(policy.TryPop(entry), Exception::TestFailed, "Policy is empty");
+		entry.task->Perform();
+		policy.RecordDispatch(entry);
+		return std::static_pointer_cast<Task<int>>(entry.task)->GetResult();
+	}
+
+	TEST_METHOD(SchedulingPolicyTest){
+		using namespace std::chrono;
+		SchedulingPolicy policy;
+		policy.SetAgingStep(milliseconds(100));
+
+		//       
+		policy.Push(MakeEntry(1, TP_MAXIMAL, milliseconds(0)));
+		policy.Push(MakeEntry(2, TP_MINIMAL, milliseconds(500)));
+		policy.Push(MakeEntry(3, TP_NORMAL, milliseconds(0)));
+		RGE_Assert(PopValue(policy) == 2, Exception::TestFailed, "Aged task wasn't promoted");
+		RGE_Assert(PopValue(policy) == 1, Exception::TestFailed, "Wrong priority order");
+		RGE_Assert(PopValue(policy) == 3, Exception::TestFailed, "Wrong priority order");
+
+		//    -        
+		auto now = IScheduler::Clock::now();
+		policy.Push(MakeEntry(4, TP_MAXIMAL, milliseconds(0)));
+		policy.Push(MakeEntry(5, TP_MINIMAL, milliseconds(0), now + milliseconds(20)));
+		policy.Push(MakeEntry(6, TP_MINIMAL, milliseconds(0), now + milliseconds(10)));
+		RGE_Assert(PopValue(policy) == 6, Exception::TestFailed, "Deadlines aren't ordered EDF");
+		RGE_Assert(PopValue(policy) == 5, Exception::TestFailed, "Deadlines aren't ordered EDF");
+		RGE_Assert(PopValue(policy) == 4, Exception::TestFailed, "Task without deadline lost");
+		RGE_Assert(policy.GetSize() == 0, Exception::TestFailed, "Wrong policy size");
+
+		LatencyStats stats = policy.GetLatency(TP_MINIMAL);
+		RGE_Assert(stats.count == 3 && stats.max >= milliseconds(500), Exception::TestFailed, "Wrong latency stats");
+	}
+#pragma endregion
+
+#pragma region FiberTest
+	static int ParallelFib(int n){
+		if(n < 2)
+			return n;
+		auto a = ThreadManager::Instance().Execute<int>([n](){ return ParallelFib(n-1); });
+		auto b = ThreadManager::Instance().Execute<int>([n](){ return ParallelFib(n-2); });
+		return a.GetResult() + b.GetResult();
+	}
+
+	TEST_METHOD(FiberTest){
+		ThreadManager& manager = ThreadManager::Instance();
+		manager.SetFiberMode(true);
+
+		//    :        
+		auto fib = manager.Execute<int>([](){ return ParallelFib(12); });
+		RGE_Assert(fib.GetResult() == 144, Exception::TestFailed, "Wrong fork-join result");
+
+		//        
+		CompletionCounter counter;
+		counter.Add(3);
+		auto waiter = manager.Execute<bool>([&counter](){ counter.Wait(); return counter.IsCompleted(); });
+		for(int i=0; i<3; i++)
+			manager.Execute<void>([&counter](){ counter.Done(); });
+		RGE_Assert(waiter.GetResult(), Exception::TestFailed, "Counter wait finished too early");
+
+		manager.WaitAllTasksCompleted();
+		manager.SetFiberMode(false);
+	}
+#pragma endregion
+
+#pragma region TelemetryTest
+	TEST_METHOD(TelemetryTest){
+		LatencyHistogram histogram;
+		histogram.Add(std::chrono::microseconds(0));
+		histogram.Add(std::chrono::microseconds(3));
+		histogram.Add(std::chrono::microseconds(100));
+
+		HistogramSnapshot snapshot = histogram.Snapshot();
+		RGE_Assert(snapshot.count == 3 && snapshot.max_us == 100, Exception::TestFailed, "Wrong histogram totals");
+		RGE_Assert(snapshot.buckets[0] == 1 && snapshot.buckets[2] == 1 && snapshot.buckets[7] == 1, Exception::TestFailed, "Wrong histogram buckets");
+		RGE_Assert(snapshot.Percentile(0.5) == 4 && snapshot.Percentile(1.0) == 100, Exception::TestFailed, "Wrong percentile");
+
+		//       
+		ThreadManager& manager = ThreadManager::Instance();
+		manager.WaitAllTasksCompleted();
+		SchedulerSnapshot before = manager.GetTelemetry();
+		for(int i=0; i<30; i++)
+			manager.Execute<void>([](){}, static_cast<TaskPriority>(i % TP_COUNT));
+		manager.WaitAllTasksCompleted();
+		SchedulerSnapshot period = manager.GetTelemetry().Since(before);
+
+		uint64_t done = 0, waited = 0;
+		for(auto& worker : period.workers){
+			done += worker.tasksDone;
+			for(int p=0; p<TP_COUNT; p++)
+				waited += worker.queueLatency[p].count;
+		}
+		RGE_Assert(done == 30 && waited == 30, Exception::TestFailed, "Wrong task count in telemetry period");
+	}
+#pragma endregion
+
+#pragma region CancellationTest
+	TEST_METHOD(CancellationTest){
+		//      
+		TaskGroup parent;
+		TaskGroup child(parent.GetToken());
+
+		std::atomic_bool started(false);
+		auto running = child.Execute<int>([&started](const CancellationToken& token){
+			started.store(true);
+			while(true)
+				token.ThrowIfCancelled();
+			return 0;
+		});
+		while(!started.load())
+			std::this_thread::yield();
+
+		parent.Cancel();
+		RGE_Assert(child.IsCancelled(), Exception::TestFailed, "Child group was not cancelled");
+		child.Wait();
+
+		bool cancelled = false;
+		try{ running.GetResult(); }
+		catch(Exception::Cancelled&){ cancelled = true; }
+		RGE_Assert(cancelled, Exception::TestFailed, "Running task ignored cancellation");
+
+		// ,   ,  
+		std::atomic_int executed(0);
+		auto late = child.Execute<void>([&executed](){ executed++; });
+		late.Wait();
+		RGE_Assert(executed.load() == 0, Exception::TestFailed, "Task ran after cancellation");
+	}
+#pragma endregion
+
+#pragma region TimerTest
+	TEST_METHOD(TimerWheelTest){
+		typedef IScheduler::Clock Clock;
+		Clock::time_point start = Clock::now();
+		TimerWheel wheel(start);
+
+		//             
+		std::vector<TimerPtr> timers;
+		for(long ms : { 3L, 200L, 70000L, 20000000L }){
+			TimerPtr timer = std::make_shared<Timer>();
+			timer->time = start + std::chrono::milliseconds(ms);
+			wheel.Insert(timer);
+			timers.push_back(timer);
+		}
+		RGE_Assert(wheel.Remove(*timers[1]) && !wheel.Remove(*timers[1]), Exception::TestFailed, "Wrong timer removal");
+
+		std::vector<TimerPtr> expired;
+		wheel.Advance(start + std::chrono::milliseconds(69999), expired);
+		RGE_Assert(expired.size() == 1 && expired[0] == timers[0], Exception::TestFailed, "Wrong timers expired");
+		wheel.Advance(start + std::chrono::hours(6), expired);
+		RGE_Assert(expired.size() == 3 && wheel.IsEmpty(), Exception::TestFailed, "Far timers did not expire");
+	}
+
+	TEST_METHOD(DelayedTaskTest){
+		ThreadManager& manager = ThreadManager::Instance();
+		IScheduler::Clock::time_point start = IScheduler::Clock::now();
+
+		auto delayed = manager.ExecuteAfter<IScheduler::Clock::time_point>([](){ return IScheduler::Clock::now(); }, std::chrono::milliseconds(30));
+		RGE_Assert(delayed.GetResult() - start >= std::chrono::milliseconds(30), Exception::TestFailed, "Delayed task ran too early");
+
+		//     :    TaskProxy       
+		manager.SetHelpingWait(true);
+		start = IScheduler::Clock::now();
+		auto early = manager.ExecuteAfter<IScheduler::Clock::time_point>([](){ return IScheduler::Clock::now(); }, std::chrono::milliseconds(30));
+		TaskProxy<IScheduler::Clock::time_point>& base = early;
+		RGE_Assert(base.GetResult() - start >= std::chrono::milliseconds(30), Exception::TestFailed, "Helping wait ran delayed task too early");
+		manager.SetHelpingWait(false);
+
+		auto cancelled = manager.ExecuteAfter<int>([](){ return 1; }, std::chrono::seconds(10));
+		RGE_Assert(cancelled.Cancel() && cancelled.GetState() == TS_DISCARDED, Exception::TestFailed, "Delayed task was not cancelled");
+		bool thrown = false;
+		try{ cancelled.GetResult(); }
+		catch(Exception::Cancelled&){ thrown = true; }
+		RGE_Assert(thrown, Exception::TestFailed, "Cancelled delayed task returned a result");
+
+		std::atomic_int ticks(0);
+		TimerHandle periodic = manager.ExecuteEvery([&ticks](){ ticks++; }, std::chrono::milliseconds(10));
+		while(ticks.load() < 3)
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		RGE_Assert(periodic.Cancel(), Exception::TestFailed, "Periodic timer was not cancelled");
+
+		manager.WaitAllTasksCompleted();
+	}
+#pragma endregion
+
+#pragma region PipelineTest
+	TEST_METHOD(PipelineTest){
+		const int ITEM_COUNT = 500;
+		const size_t MAX_TOKENS = 4;
+
+		std::atomic_int inFlight(0), maxInFlight(0);
+		std::vector<int> order;
+
+		Pipeline<int> pipeline(MAX_TOKENS);
+		pipeline.AddStage(SM_PARALLEL, [&](int& item){
+				int count = ++inFlight;
+				int max = maxInFlight.load();
+				while(count > max && !maxInFlight.compare_exchange_weak(max, count));
+				item *= 2;
+			})
+			.AddStage(SM_SERIAL_IN_ORDER, [&](int& item){ order.push_back(item); })
+			.AddStage(SM_PARALLEL, [&](int&){ inFlight--; });
+
+		int next = 0;
+		pipeline.Run([&](int& item){
+			if(next == ITEM_COUNT)
+				return false;
+			item = next++;
+			return true;
+		});
+
+		RGE_Assert(order.size() == ITEM_COUNT, Exception::TestFailed, "Items were lost");
+		for(int i=0; i<ITEM_COUNT; i++)
+			RGE_Assert(order[i] == 2 * i, Exception::TestFailed, "Serial stage broke source order");
+		RGE_Assert(maxInFlight.load() <= MAX_TOKENS, Exception::TestFailed, "Too many items in flight");
+	}
+
+	TEST_METHOD(PipelineFailureTest){
+		Pipeline<int> pipeline(1);									//   ,   
+		pipeline.AddStage(SM_SERIAL_IN_ORDER, [](int& item){
+			if(item == 3)
+				RGE_Throw(Exception::WrongState, "Stage failed");
+		});
+
+		int next = 0;
+		bool caught = false;
 		try{
-			for(int i = 0; i<workersPerAction; i++){
-				pushBackTask.GetSubtask(i).GetResult();
-				pushFrontTask.GetSubtask(i).GetResult();
-				popBackTask.GetSubtask(i).GetResult();
-				popFrontTask.GetSubtask(i).GetResult();
+			pipeline.Run([&](int& item){
+				item = next++;
+				return true;
+			});
+		}
+		catch(Exception::WrongState&){
+			caught = true;
+		}
+		RGE_Assert(caught, Exception::TestFailed, "Stage exception wasn't rethrown");
+		RGE_Assert(next == 4, Exception::TestFailed, "Source wasn't stopped");
+	}
+#pragma endregion
+
+#pragma region RingQueueTest
+	TEST_METHOD(RingQueueTest){
+		const int elemCount = 100000;
+
+		//   ,   :  
+		SPSCQueue<int> spsc(100);
+		RGE_Assert(spsc.capacity() == 128, Exception::TestFailed, "Capacity is not a power of two");
+
+		std::thread producer([&](){
+			int batch[16];
+			for(int i=0; i<elemCount; i+=16){
+				int count = std::min(16, elemCount - i);
+				for(int j=0; j<count; j++)
+					batch[j] = i + j;
+				for(int pushed = 0; pushed < count; )
+					pushed += static_cast<int>( spsc.push_n(batch + pushed, count - pushed) );
 			}
+		});
+
+		int expected = 0, batch[32];
+		bool ordered = true;
+		while(expected < elemCount){
+			size_t count = spsc.pop_n(batch, 32);
+			for(size_t j=0; j<count; j++)
+				ordered &= batch[j] == expected++;
 		}
-		catch(std::exception& e){
-			printf("%s\n", e.what());
+		producer.join();
+		RGE_Assert(ordered && spsc.empty(), Exception::TestFailed, "SPSCQueue broke the order");
+
+		//     :     
+		const int producerCount = 4;
+		MPSCQueue<int, true> mpsc(64);
+		std::vector<std::thread> producers;
+		for(int p=0; p<producerCount; p++)
+			producers.emplace_back([&mpsc, p, elemCount](){
+				for(int i=0; i<elemCount; i++)
+					mpsc.push(p * elemCount + i);
+			});
+
+		std::vector<int> last(producerCount, -1);
+		for(int i=0; i<producerCount * elemCount; i++){
+			int val;
+			mpsc.pop(&val);
+			ordered &= val % elemCount == last[val / elemCount] + 1;
+			last[val / elemCount] = val % elemCount;
 		}
+		for(auto& th : producers)
+			th.join();
+		RGE_Assert(ordered && mpsc.empty(), Exception::TestFailed, "MPSCQueue broke the order of a producer");
+	}
+#pragma endregion
 
-		RGE_Assert(list.empty(), Exception::TestFailed, "List is not empty");
-		for(int i = 0; i<workersPerAction; i++){
-			RGE_Assert(pushCounter[i] == popCounter[i], Exception::TestFailed, "Not all values was processed correctly");
+#pragma region ElasticScalingTest
+//  ,      ;        
+	static bool WaitUntil(const std::function<bool()>& condition, int seconds = 10){
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+		while(!condition()){
+			if(std::chrono::steady_clock::now() > deadline)
+				return false;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return true;
+	}
+
+	TEST_METHOD(ElasticScalingTest){
+		ThreadManager& manager = ThreadManager::Instance();
+		uint8_t workersCount = manager.GetWorkersCount();
+
+		manager.SetMinWorkersCount(1);
+		manager.SetWorkersCount(1);
+		manager.SetIdleTimeout(100);
+		manager.SetScaleUpDelay(10);
+		manager.SetElasticScaling(true);
+
+		//   ,    , -  
+		std::atomic_bool release(false);
+		for(int i=0; i<300; i++)
+			manager.Execute<void>([&release](){
+				while(!release)
+					std::this_thread::yield();
+			});
+		bool grown = WaitUntil([&](){ return manager.GetWorkersCount() > 1; });
+		release = true;
+		manager.WaitAllTasksCompleted();
+		RGE_Assert(grown, Exception::TestFailed, "Pool did not grow under load");
+
+		//     
+		RGE_Assert(WaitUntil([&](){ return manager.GetWorkersCount() == 1; }), Exception::TestFailed, "Idle workers were not retired");
+
+		// ,     ,   ,   
+		manager.SetFiberMode(true);
+		manager.SetIdleTimeout(20);
+		auto waiting = manager.Execute<int>([&manager](){
+			return manager.ExecuteAfter<int>([](){ return 1; }, std::chrono::milliseconds(200)).GetResult();
+		});
+		RGE_Assert(waiting.GetResult() == 1, Exception::TestFailed, "Fiber wait was lost");
+		manager.SetFiberMode(false);
+
+		manager.SetElasticScaling(false);
+		manager.SetWorkersCount(workersCount);
+	}
+#pragma endregion
+
+#pragma region BatchTest
+	TEST_METHOD(BatchTest){
+		ThreadManager& manager = ThreadManager::Instance();
+
+		//   
+		std::atomic<size_t> sum(0);
+		auto batch = manager.ExecuteBatch<size_t>([&](size_t i){ sum += i; return 2 * i; }, 5000);
+		batch.Wait();
+		RGE_Assert(batch.GetTaskState() == TS_READY, Exception::TestFailed, "Batch is not completed");
+		RGE_Assert(sum == 4999 * 5000 / 2, Exception::TestFailed, "Not all batch tasks were performed");
+		for(size_t i=0; i<batch.GetTaskCount(); i++)
+			RGE_Assert(batch.GetResult(i) == 2 * i, Exception::TestFailed, "Wrong batch task result");
+
+		//    
+		std::atomic<int> count(0);
+		std::vector< std::function<void()> > functions(1000, [&](){ count++; });
+		manager.ExecuteBatch<void>(std::span< std::function<void()> >(functions), TP_MAXIMAL).Wait();
+		RGE_Assert(count == 1000, Exception::TestFailed, "Not all batch functions were performed");
+
+		//     
+		auto failed = manager.ExecuteBatch<int>([](size_t i) -> int{ if(i == 3) throw std::exception(); return 0; }, 8);
+		bool thrown = false;
+		try{ failed.GetResult(3); }
+		catch(std::exception&){ thrown = true; }
+		RGE_Assert(thrown && failed.GetResult(4) == 0, Exception::TestFailed, "Batch task exception was lost");
+
+		manager.WaitAllTasksCompleted();
+	}
+#pragma endregion
+
+#pragma region HelpingWaitTest
+	TEST_METHOD(HelpingWaitTest){
+		ThreadManager& manager = ThreadManager::Instance();
+		uint8_t workersCount = manager.GetWorkersCount();
+		manager.SetWorkersCount(1);
+		manager.SetHelpingWait(true);
+
+		//    -     
+		std::atomic_bool release(false);
+		auto blocker = manager.Execute<void>([&](){
+			while(!release)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		});
+		std::thread::id waiter = std::this_thread::get_id();
+		auto task = manager.Execute<bool>([&](){ return std::this_thread::get_id() == waiter; });
+		RGE_Assert(task.GetResult(), Exception::TestFailed, "Waiting thread did not perform the awaited task");
+
+		std::atomic<int> count(0);
+		for(int i=0; i<100; i++)
+			manager.Execute<void>([&](){ count++; });
+		manager.ExecuteBatch<void>([&](size_t){ count++; }, 100).Wait();
+		RGE_Assert(count >= 100, Exception::TestFailed, "Waiting thread did not help with the batch");
+
+		//      
+		auto start = std::chrono::steady_clock::now();
+		auto delayed = manager.ExecuteAfter<int>([](){ return 1; }, std::chrono::milliseconds(50));
+		release = true;
+		delayed.Wait();
+		RGE_Assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50), Exception::TestFailed, "Delayed task was performed too early");
+
+		manager.WaitAllTasksCompleted();
+		RGE_Assert(count == 200 && blocker.GetState() == TS_READY, Exception::TestFailed, "Not all tasks were completed");
+
+		manager.SetHelpingWait(false);
+		manager.SetWorkersCount(workersCount);
+	}
+#pragma endregion
+
+#pragma region JobGraphTest
+	TEST_METHOD(JobGraphTest){
+		std::atomic<int> first(0), left(0), right(0), last(0), wrongOrder(0);
+
+		// : first -> (left, right) -> last
+		JobGraph graph;
+		auto a = graph.AddNode([&](size_t, size_t){ first++; }, 8);
+		auto b = graph.AddNode([&](size_t, size_t){ if(first != 8) wrongOrder++; left++; }, 4);
+		auto c = graph.AddNode([&](size_t, size_t){ if(first != 8) wrongOrder++; right++; }, 16);
+		auto d = graph.AddNode([&](size_t, size_t){ if(left != 4 || right != 16) wrongOrder++; last++; });
+		graph.AddEdge(a, b);
+		graph.AddEdge(a, c);
+		graph.AddEdge(b, d);
+		graph.AddEdge(c, d);
+		graph.Compile();
+		RGE_Assert(graph.GetTaskCount() == 29 && graph.GetOrder().front() == a && graph.GetOrder().back() == d, Exception::TestFailed, "Wrong job graph order");
+
+		//    
+		for(int frame=0; frame<100; frame++){
+			first = left = right = last = 0;
+			graph.Kick();
+			graph.Wait();
+			RGE_Assert(last == 1, Exception::TestFailed, "Job graph run is not completed");
 		}
+		RGE_Assert(wrongOrder == 0, Exception::TestFailed, "Job graph dependencies were violated");
+
+		//    
+		JobGraph cycle;
+		auto x = cycle.AddNode([](size_t, size_t){});
+		auto y = cycle.AddNode([](size_t, size_t){});
+		cycle.AddEdge(x, y);
+		cycle.AddEdge(y, x);
+		bool thrown = false;
+		try{ cycle.Compile(); }
+		catch(Exception::WrongState&){ thrown = true; }
+		RGE_Assert(thrown, Exception::TestFailed, "Job graph cycle was not detected");
+
+		//        Wait
+		JobGraph failing;
+		bool performed = false;
+		auto head = failing.AddNode([](size_t part, size_t){ if(part == 1) throw std::exception(); }, 3);
+		auto tail = failing.AddNode([&](size_t, size_t){ performed = true; });
+		failing.AddEdge(head, tail);
+		failing.Compile();
+		failing.Kick();
+		thrown = false;
+		try{ failing.Wait(); }
+		catch(std::exception&){ thrown = true; }
+		RGE_Assert(thrown && !performed, Exception::TestFailed, "Job graph exception was lost");
+
+		//      Wait:       
+		std::atomic<int> parts(0);
+		for(int i=0; i<1000; i++){
+			std::unique_ptr<JobGraph> shortLived(new JobGraph());
+			auto first = shortLived->AddNode([&](size_t, size_t){ parts++; }, 4);
+			auto second = shortLived->AddNode([&](size_t, size_t){ parts++; }, 4);
+			shortLived->AddEdge(first, second);
+			shortLived->Compile();
+			shortLived->Kick();
+			shortLived->Wait();
+		}
+		RGE_Assert(parts == 8000, Exception::TestFailed, "Short-lived job graph lost parts");
 	}
+#pragma endregion
+
+#pragma region AffinityTest
+	TEST_METHOD(AffinityTest){
+		ThreadManager& manager = ThreadManager::Instance();
+		uint8_t workersCount = manager.GetWorkersCount();
+		manager.SetWorkersCount(4);
+
+		auto whoAmI = [](){ return Thread::Current()->LocalID(); };
+		RGE_Assert(Thread::Current() == nullptr, Exception::TestFailed, "Test thread is not a Thread");
+
+		//         ,    
+		int data;
+		uint16_t byIndex	= manager.Execute<uint16_t>(whoAmI, TaskAffinity::Worker(2)).GetResult();
+		uint16_t byKey		= manager.Execute<uint16_t>(whoAmI, TaskAffinity::Key(&data)).GetResult();
+		for(int i=0; i<20; i++){
+			RGE_Assert(manager.Execute<uint16_t>(whoAmI, TaskAffinity::Worker(2)).GetResult() == byIndex, Exception::TestFailed, "Worker affinity was not honoured");
+			RGE_Assert(manager.Execute<uint16_t>(whoAmI, TaskAffinity::Key(&data)).GetResult() == byKey, Exception::TestFailed, "Key affinity was not honoured");
+		}
+
+		//    -
+		std::atomic<int> sameWorker(0);
+		for(int i=0; i<20; i++){
+			manager.Execute<void>([&](){
+				uint16_t spawner = Thread::Current()->LocalID();
+				manager.Execute<void>([&sameWorker, spawner](){
+					if(Thread::Current()->LocalID() == spawner)
+						sameWorker++;
+				}, TaskAffinity::Spawner());
+			});
+			manager.WaitAllTasksCompleted();
+		}
+		RGE_Assert(sameWorker == 20, Exception::TestFailed, "Spawner affinity was not honoured");
+
+		//         
+		uint8_t maxTaskCount = manager.GetMaxTaskCount();
+		manager.SetMaxTaskCount(100);
+		manager.SetHelpingWait(true);
+		std::atomic<int> foreign(0);
+		for(int i=0; i<30; i++)
+			manager.Execute<void>([&foreign, byIndex](){
+				std::this_thread::sleep_for(std::chrono::microseconds(300));
+				if(Thread::Current() == nullptr || Thread::Current()->LocalID() != byIndex)
+					foreign++;
+			}, TaskAffinity::Worker(2));
+		manager.WaitAllTasksCompleted();
+		manager.SetHelpingWait(false);
+		manager.SetMaxTaskCount(maxTaskCount);
+		RGE_Assert(foreign == 0, Exception::TestFailed, "Helping wait took a pinned task");
+
+		manager.SetWorkersCount(workersCount);
+	}
+#pragma endregion
 
-#endif
+#pragma region BlockingRegionTest
+	TEST_METHOD(BlockingRegionTest){
+		ThreadManager& manager = ThreadManager::Instance();
+		uint8_t workersCount = manager.GetWorkersCount();
+		manager.SetWorkersCount(1);
+
+		//    -    
+		std::atomic_bool release(false), entered(false), compensated(false), nested(false);
+		manager.Execute<void>([&](){
+			BlockingRegion region;
+			compensated = region.IsCompensated();
+			{
+				BlockingRegion inner;
+				nested = inner.IsCompensated();
+			}
+			entered = true;
+			while(!release)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		});
+		WaitUntil([&](){ return entered.load(); });
+
+		std::atomic<int> count(0);
+		for(int i=0; i<20; i++)
+			manager.Execute<void>([&](){ count++; });
+		WaitUntil([&](){ return count == 20; });
+		RGE_Assert(compensated && !nested, Exception::TestFailed, "Blocking region was not compensated");
+		RGE_Assert(count == 20 && manager.GetBlockedThreadsCount() == 1, Exception::TestFailed, "Tasks were not performed while worker was blocked");
+
+		//         
+		release = true;
+		manager.WaitAllTasksCompleted();
+		WaitUntil([&](){ return manager.GetSpareThreadsCount() != 0; });
+		RGE_Assert(manager.GetWorkersCount() == 1 && manager.GetBlockedThreadsCount() == 0, Exception::TestFailed, "Compensation thread was not retired");
+		RGE_Assert(manager.GetThreadsCount() <= manager.GetMaxThreadCount(), Exception::TestFailed, "Spare thread exceeds thread limit");
+
+		//  ,  IdleTimeout,  
+		manager.SetIdleTimeout(20);
+		bool retired = WaitUntil([&](){
+			manager.Execute<void>([](){}).Wait();				//   ,     
+			return manager.GetSpareThreadsCount() == 0;
+		});
+		RGE_Assert(retired, Exception::TestFailed, "Spare thread was not retired");
+		manager.SetIdleTimeout(5000);
+
+		//      
+		BlockingRegion outside;
+		RGE_Assert(!outside.IsCompensated(), Exception::TestFailed, "Non-worker thread was compensated");
+
+		manager.SetWorkersCount(workersCount);
+	}
+#pragma endregion
+
+#pragma region WorkerContextTest
+	TEST_METHOD(WorkerContextTest){
+		ThreadManager& manager = ThreadManager::Instance();
+		RGE_Assert(WorkerContext::Current() == nullptr, Exception::TestFailed, "Test thread has worker context");
+
+		//       
+		std::atomic<int> errors(0);
+		uint64_t before = manager.GetStatSlotTotal(0);
+		for(int i=0; i<500; i++)
+			manager.Execute<void>([&](){
+				WorkerContext* context = WorkerContext::Current();
+				if(context == nullptr || context->GetScratch().GetUsedMemorySize() != 0){
+					errors++;
+					return;
+				}
+				double* values = context->Allocate<double>(1000);
+				if(reinterpret_cast<uintptr_t>(values) % alignof(double) != 0)
+					errors++;
+				for(int j=0; j<1000; j++)
+					values[j] = j;
+				context->AddToStatSlot(0, 1);
+			});
+		manager.WaitAllTasksCompleted();
+		RGE_Assert(errors == 0, Exception::TestFailed, "Scratch arena was not reset between tasks");
+		RGE_Assert(manager.GetStatSlotTotal(0) - before == 500, Exception::TestFailed, "Wrong stat slot total");
+
+		//       NextFrame
+		WorkerContext::SetResetMode(SR_FRAME);
+		uint32_t used = manager.Execute<uint32_t>([](){
+			WorkerContext::Current()->Allocate(64);
+			return WorkerContext::Current()->GetScratch().GetUsedMemorySize();
+		}, TaskAffinity::Worker(0)).GetResult();
+		uint32_t kept = manager.Execute<uint32_t>([](){ return WorkerContext::Current()->GetScratch().GetUsedMemorySize(); }, TaskAffinity::Worker(0)).GetResult();
+		WorkerContext::NextFrame();
+		uint32_t reset = manager.Execute<uint32_t>([](){ return WorkerContext::Current()->GetScratch().GetUsedMemorySize(); }, TaskAffinity::Worker(0)).GetResult();
+		WorkerContext::SetResetMode(SR_TASK);
+		RGE_Assert(used >= 64 && kept == used && reset == 0, Exception::TestFailed, "Frame scratch reset failed");
+
+		//    ,       ,    
+		manager.SetFiberMode(true);
+		std::atomic_bool allocated(false);
+		auto waiter = manager.Execute<bool>([&allocated](){
+			int* data = WorkerContext::Current()->Allocate<int>(1000);
+			for(int i=0; i<1000; i++)
+				data[i] = i;
+			allocated = true;
+			ThreadManager::Instance().ExecuteAfter<int>([](){ return 1; }, std::chrono::milliseconds(200)).GetResult();
+			for(int i=0; i<1000; i++)
+				if(data[i] != i)
+					return false;
+			return true;
+		}, TaskAffinity::Worker(0));
+		WaitUntil([&](){ return allocated.load(); });		//       ,   
+		errors = 0;
+		for(int i=0; i<20; i++)
+			manager.Execute<void>([&](){
+				try{
+					WorkerContext* context = WorkerContext::Current();
+					memset(context->Allocate(WorkerContext::GetScratchSize() / 3), 0xFF, WorkerContext::GetScratchSize() / 3);
+					context->ResetScratch();
+					memset(context->Allocate(WorkerContext::GetScratchSize() / 3), 0xFF, WorkerContext::GetScratchSize() / 3);
+				}
+				catch(...){
+					errors++;
+				}
+			}, TaskAffinity::Worker(0));
+		RGE_Assert(waiter.GetResult(), Exception::TestFailed, "Suspended fiber scratch was overwritten");
+		manager.WaitAllTasksCompleted();
+		manager.SetFiberMode(false);
+		RGE_Assert(errors == 0, Exception::TestFailed, "Scratch arena overflowed while fiber was waiting");
+	}
+#pragma endregion
 };
 
 